@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ANDROID_HARDWARE_THERMAL_V1_1_BOARDPROFILE_H
+#define ANDROID_HARDWARE_THERMAL_V1_1_BOARDPROFILE_H
+
+#include <math.h>
+#include <stdint.h>
+
+#include <array>
+
+#include "SeverityEngine.h"
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+struct BoardZone {
+    // Zone directory and the content of its type file, checked when the
+    // profile is applied; power supplies go by their directory name.
+    const char *dir;
+    const char *type;
+    SeverityThresholds hot;
+    SeverityThresholds cold;
+    uint32_t periodMs;
+};
+
+struct BoardCluster {
+    const char *name;
+    int firstCpu;
+    int lastCpu;
+    // The watcher thread runs here unless vendor.thermal.cpus says otherwise.
+    bool little;
+};
+
+struct BoardActuator {
+    const char *name;
+    // Cooling device directory; its cur_state is recorded after every
+    // evaluation.
+    const char *dir;
+};
+
+// Everything the service would otherwise find in sysfs and the
+// configuration file, for SoCs whose sensor set never changes.
+template <size_t Zones, size_t Clusters, size_t Actuators>
+struct BoardProfile {
+    const char *name;
+    std::array<BoardZone, Zones> zones;
+    std::array<BoardCluster, Clusters> clusters;
+    std::array<BoardActuator, Actuators> actuators;
+};
+
+// Boards pick one with the renesas_thermal.board Soong variable, see
+// Android.bp; the service then starts without scanning sysfs or reading
+// thermal-renesas.conf. The thresholds follow the passive and critical trip
+// points of each SoC's device tree.
+namespace boards {
+
+#define THERMAL_BOARD_HOT   {NAN, NAN, NAN, 100.f, NAN, 120.f}
+#define THERMAL_BOARD_COLD  {NAN, NAN, NAN, 98.f, NAN, 118.f}
+
+// R-Car H3 (r8a7795): three THS channels, 4x Cortex-A57 and 4x Cortex-A53.
+constexpr BoardProfile<3, 2, 1> h3 = {
+    "r8a7795",
+    {{
+        {"/sys/class/thermal/thermal_zone0", "sensor-thermal1", THERMAL_BOARD_HOT,
+         THERMAL_BOARD_COLD, 1000},
+        {"/sys/class/thermal/thermal_zone1", "sensor-thermal2", THERMAL_BOARD_HOT,
+         THERMAL_BOARD_COLD, 1000},
+        {"/sys/class/thermal/thermal_zone2", "sensor-thermal3", THERMAL_BOARD_HOT,
+         THERMAL_BOARD_COLD, 1000},
+    }},
+    {{
+        {"a57", 0, 3, false},
+        {"a53", 4, 7, true},
+    }},
+    {{
+        {"thermal-cpufreq-0", "/sys/class/thermal/cooling_device0"},
+    }},
+};
+
+// R-Car M3-W (r8a7796): three THS channels, 2x Cortex-A57 and 4x Cortex-A53.
+constexpr BoardProfile<3, 2, 1> m3w = {
+    "r8a7796",
+    {{
+        {"/sys/class/thermal/thermal_zone0", "sensor-thermal1", THERMAL_BOARD_HOT,
+         THERMAL_BOARD_COLD, 1000},
+        {"/sys/class/thermal/thermal_zone1", "sensor-thermal2", THERMAL_BOARD_HOT,
+         THERMAL_BOARD_COLD, 1000},
+        {"/sys/class/thermal/thermal_zone2", "sensor-thermal3", THERMAL_BOARD_HOT,
+         THERMAL_BOARD_COLD, 1000},
+    }},
+    {{
+        {"a57", 0, 1, false},
+        {"a53", 2, 5, true},
+    }},
+    {{
+        {"thermal-cpufreq-0", "/sys/class/thermal/cooling_device0"},
+    }},
+};
+
+// R-Car M3-N (r8a77965): three THS channels, 2x Cortex-A57.
+constexpr BoardProfile<3, 1, 1> m3n = {
+    "r8a77965",
+    {{
+        {"/sys/class/thermal/thermal_zone0", "sensor-thermal1", THERMAL_BOARD_HOT,
+         THERMAL_BOARD_COLD, 1000},
+        {"/sys/class/thermal/thermal_zone1", "sensor-thermal2", THERMAL_BOARD_HOT,
+         THERMAL_BOARD_COLD, 1000},
+        {"/sys/class/thermal/thermal_zone2", "sensor-thermal3", THERMAL_BOARD_HOT,
+         THERMAL_BOARD_COLD, 1000},
+    }},
+    {{
+        {"a57", 0, 1, false},
+    }},
+    {{
+        {"thermal-cpufreq-0", "/sys/class/thermal/cooling_device0"},
+    }},
+};
+
+// R-Car E3 (r8a77990): one sensor, 2x Cortex-A53.
+constexpr BoardProfile<1, 1, 1> e3 = {
+    "r8a77990",
+    {{
+        {"/sys/class/thermal/thermal_zone0", "cpu-thermal", THERMAL_BOARD_HOT,
+         THERMAL_BOARD_COLD, 1000},
+    }},
+    {{
+        {"a53", 0, 1, false},
+    }},
+    {{
+        {"thermal-cpufreq-0", "/sys/class/thermal/cooling_device0"},
+    }},
+};
+
+#undef THERMAL_BOARD_HOT
+#undef THERMAL_BOARD_COLD
+
+}  // namespace boards
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
+
+#endif  // ANDROID_HARDWARE_THERMAL_V1_1_BOARDPROFILE_H
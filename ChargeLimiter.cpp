@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "ThermalHAL"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <android-base/file.h>
+#include <android-base/stringprintf.h>
+#include <android-base/strings.h>
+#include <log/log.h>
+
+#include "ChargeLimiter.h"
+
+#define CHARGE_LIMIT_FILE       "constant_charge_current_max"
+#define CHARGE_HYSTERESIS       2.f
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+bool ChargeLimiter::addSupply(const std::string& name, const std::string& dir,
+                              const std::vector<ChargeStep>& steps, OriginalValues* originals) {
+    // Chargers and USB ports have the attribute too, but it limits what
+    // they supply rather than what the battery takes.
+    std::string type;
+    if (steps.empty() || !::android::base::ReadFileToString(dir + "/type", &type) ||
+        ::android::base::Trim(type) != "Battery") {
+        return false;
+    }
+    Supply supply;
+    supply.name = name;
+    supply.steps = steps;
+    const std::string path = dir + "/" CHARGE_LIMIT_FILE;
+    supply.limitFd.reset(TEMP_FAILURE_RETRY(open(path.c_str(), O_RDWR | O_CLOEXEC)));
+    char buf[32];
+    const ssize_t len = supply.limitFd < 0
+            ? -1
+            : TEMP_FAILURE_RETRY(pread(supply.limitFd, buf, sizeof(buf) - 1, 0));
+    if (len <= 0) {
+        return false;
+    }
+    buf[len] = '\0';
+    std::string limit = ::android::base::Trim(buf);
+    if (originals != nullptr) {
+        limit = originals->keep(path, limit);
+    }
+    supply.originalUa = strtoull(limit.c_str(), nullptr, 10);
+    if (supply.originalUa == 0) {
+        return false;
+    }
+    ALOGI("%s: %s charges at up to %" PRIu64 " uA", __func__, name.c_str(), supply.originalUa);
+    mSupplies.push_back(std::move(supply));
+    return true;
+}
+
+bool ChargeLimiter::writeLimit(Supply& supply) {
+    const uint64_t limitUa = supply.engaged == 0
+            ? supply.originalUa
+            : supply.originalUa * supply.steps[supply.engaged - 1].percent / 100;
+    char buf[32];
+    // Terminated like echo would, which also ends the number where a
+    // longer one was before in files that pwrite() does not truncate.
+    const int len = snprintf(buf, sizeof(buf), "%" PRIu64 "\n", limitUa);
+    if (TEMP_FAILURE_RETRY(pwrite(supply.limitFd, buf, len, 0)) != len) {
+        // Logged once; the next change tries again.
+        if (!supply.failed) {
+            ALOGE("%s: cannot limit %s to %" PRIu64 " uA: %s", __func__, supply.name.c_str(),
+                  limitUa, strerror(errno));
+        }
+        supply.failed = true;
+        return false;
+    }
+    supply.failed = false;
+    return true;
+}
+
+bool ChargeLimiter::update(float headroom) {
+    if (isnan(headroom)) {
+        return false;
+    }
+    bool changed = false;
+    for (auto& supply : mSupplies) {
+        size_t engaged = supply.engaged;
+        while (engaged < supply.steps.size() && headroom <= supply.steps[engaged].margin) {
+            ++engaged;
+        }
+        while (engaged > 0 && headroom > supply.steps[engaged - 1].margin + CHARGE_HYSTERESIS) {
+            --engaged;
+        }
+        if (engaged != supply.engaged) {
+            supply.engaged = engaged;
+            writeLimit(supply);
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+uint32_t ChargeLimiter::state() const {
+    uint32_t state = 0;
+    for (const auto& supply : mSupplies) {
+        state += supply.engaged;
+    }
+    return state;
+}
+
+float ChargeLimiter::engageMargin() const {
+    float margin = NAN;
+    for (const auto& supply : mSupplies) {
+        if (supply.engaged < supply.steps.size()) {
+            margin = fmaxf(margin, supply.steps[supply.engaged].margin);
+        }
+    }
+    return margin;
+}
+
+float ChargeLimiter::releaseMargin() const {
+    float margin = NAN;
+    for (const auto& supply : mSupplies) {
+        if (supply.engaged > 0) {
+            margin = fminf(margin, supply.steps[supply.engaged - 1].margin + CHARGE_HYSTERESIS);
+        }
+    }
+    return margin;
+}
+
+void ChargeLimiter::restore() {
+    for (auto& supply : mSupplies) {
+        if (supply.engaged > 0) {
+            supply.engaged = 0;
+            writeLimit(supply);
+        }
+    }
+}
+
+void ChargeLimiter::dump(std::string* out) const {
+    for (const auto& supply : mSupplies) {
+        const uint32_t percent =
+                supply.engaged == 0 ? 100 : supply.steps[supply.engaged - 1].percent;
+        ::android::base::StringAppendF(
+                out, "  charge limit %s: %u%% of %" PRIu64 " uA, step %zu of %zu%s\n",
+                supply.name.c_str(), percent, supply.originalUa, supply.engaged,
+                supply.steps.size(), supply.failed ? " (write failed)" : "");
+    }
+}
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ANDROID_HARDWARE_THERMAL_V1_1_CHARGELIMITER_H
+#define ANDROID_HARDWARE_THERMAL_V1_1_CHARGELIMITER_H
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include <android-base/unique_fd.h>
+
+#include "OriginalValues.h"
+#include "ThermalConfig.h"
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+// Lowers the charge current of power supplies as the hottest zone gets
+// close to its first hot threshold, so that charging gives up its share of
+// the thermal budget before the CPU and GPU are capped. Not thread-safe;
+// owned by the watcher thread.
+class ChargeLimiter {
+  public:
+    ChargeLimiter() = default;
+    ChargeLimiter(const ChargeLimiter&) = delete;
+    ChargeLimiter& operator=(const ChargeLimiter&) = delete;
+
+    // Takes over the supply in dir if it is a battery with a writable
+    // constant_charge_current_max and steps to follow. Returns false
+    // otherwise. The limit to scale and restore is the one originals has
+    // for the supply, if given, so that it stays put across restarts.
+    bool addSupply(const std::string& name, const std::string& dir,
+                   const std::vector<ChargeStep>& steps, OriginalValues* originals);
+    bool empty() const { return mSupplies.empty(); }
+
+    // headroom is the smallest distance in degrees Celsius between a zone
+    // and its first hot threshold, NAN if unknown. Returns true if a limit
+    // changed.
+    bool update(float headroom);
+
+    // Steps engaged, summed over the supplies.
+    uint32_t state() const;
+    // The largest headroom at which a further step engages, and the
+    // smallest at which an engaged one is released; NAN if there is none.
+    float engageMargin() const;
+    float releaseMargin() const;
+
+    // Puts every supply back to its original limit.
+    void restore();
+    // Appends the state of every supply to out.
+    void dump(std::string* out) const;
+
+  private:
+    struct Supply {
+        std::string name;
+        ::android::base::unique_fd limitFd;
+        // Microamps before the first write of this boot.
+        uint64_t originalUa;
+        std::vector<ChargeStep> steps;
+        size_t engaged = 0;
+        bool failed = false;
+    };
+
+    bool writeLimit(Supply& supply);
+
+    std::vector<Supply> mSupplies;
+};
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
+
+#endif  // ANDROID_HARDWARE_THERMAL_V1_1_CHARGELIMITER_H
@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "ThermalHAL"
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include <android-base/file.h>
+#include <android-base/strings.h>
+#include <log/log.h>
+
+#include "CpuIdle.h"
+
+#define CPUIDLE_STATE_FORMAT    "%s/cpu%zu/cpuidle/state%zu"
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+static bool readCounter(int fd, uint64_t* value) {
+    char buf[24];
+    const ssize_t len = TEMP_FAILURE_RETRY(pread(fd, buf, sizeof(buf) - 1, 0));
+    if (len <= 0) {
+        return false;
+    }
+    buf[len] = '\0';
+    char *end;
+    *value = strtoull(buf, &end, 10);
+    return end != buf;
+}
+
+bool CpuIdle::openState(State* state) {
+    state->timeFd.reset(TEMP_FAILURE_RETRY(
+            ::open((state->dir + "/time").c_str(), O_RDONLY | O_CLOEXEC)));
+    state->usageFd.reset(TEMP_FAILURE_RETRY(
+            ::open((state->dir + "/usage").c_str(), O_RDONLY | O_CLOEXEC)));
+    return state->timeFd >= 0 && state->usageFd >= 0;
+}
+
+bool CpuIdle::open(const std::string& root) {
+    for (size_t cpu = 0;; ++cpu) {
+        char path[128];
+        snprintf(path, sizeof(path), "%s/cpu%zu", root.c_str(), cpu);
+        if (access(path, F_OK) != 0) {
+            break;
+        }
+        Cpu entry;
+        entry.first = mStates.size();
+        for (size_t s = 0;; ++s) {
+            snprintf(path, sizeof(path), CPUIDLE_STATE_FORMAT, root.c_str(), cpu, s);
+            State state;
+            state.cpu = cpu;
+            state.dir = path;
+            if (!openState(&state)) {
+                break;
+            }
+            if (!::android::base::ReadFileToString(state.dir + "/name", &state.name)) {
+                state.name = "state" + std::to_string(s);
+            }
+            state.name = ::android::base::Trim(state.name);
+            mStates.push_back(std::move(state));
+        }
+        entry.count = mStates.size() - entry.first;
+        mCpus.push_back(entry);
+    }
+    if (mStates.empty()) {
+        mCpus.clear();
+        return false;
+    }
+    mValues.resize(mStates.size() * 2);
+    mValid.resize(mCpus.size());
+    mReopen.resize(mCpus.size());
+    mFailing.resize(mCpus.size());
+    ALOGI("%s: %zu idle states over %zu CPUs", __func__, mStates.size(), mCpus.size());
+    return true;
+}
+
+void CpuIdle::setOnline(int cpu) {
+    if (cpu >= 0 && static_cast<size_t>(cpu) < mReopen.size()) {
+        mReopen[cpu] = true;
+    }
+}
+
+bool CpuIdle::readCpu(const Cpu& cpu, uint64_t* values) {
+    for (size_t s = cpu.first; s < cpu.first + cpu.count; ++s) {
+        if (!readCounter(mStates[s].timeFd, &values[2 * s]) ||
+            !readCounter(mStates[s].usageFd, &values[2 * s + 1])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void CpuIdle::sample(int64_t nowNs) {
+    // Reading takes most of the round, so it happens before taking the
+    // lock; only this thread writes the counters and the descriptors.
+    uint64_t *values = mValues.data();
+    for (size_t c = 0; c < mCpus.size(); ++c) {
+        if (mReopen[c]) {
+            mReopen[c] = false;
+            for (size_t s = mCpus[c].first; s < mCpus[c].first + mCpus[c].count; ++s) {
+                openState(&mStates[s]);
+            }
+        }
+        mValid[c] = readCpu(mCpus[c], values);
+        // The first failure in a row gets the files opened again; an
+        // offline CPU is then left alone until it comes back.
+        if (!mValid[c] && !mFailing[c]) {
+            mReopen[c] = true;
+        }
+        mFailing[c] = !mValid[c];
+    }
+
+    std::lock_guard<std::mutex> _lock(mLock);
+    for (size_t c = 0; c < mCpus.size(); ++c) {
+        Cpu& cpu = mCpus[c];
+        if (!mValid[c] || cpu.count == 0) {
+            cpu.lastNs = 0;
+            cpu.windowNs = 0;
+            continue;
+        }
+        cpu.windowNs = cpu.lastNs != 0 ? nowNs - cpu.lastNs : 0;
+        cpu.lastNs = nowNs;
+        for (size_t s = cpu.first; s < cpu.first + cpu.count; ++s) {
+            State& state = mStates[s];
+            state.windowUs = values[2 * s] - std::min(values[2 * s], state.timeUs);
+            state.windowUsage = values[2 * s + 1] - std::min(values[2 * s + 1], state.usage);
+            state.timeUs = values[2 * s];
+            state.usage = values[2 * s + 1];
+        }
+    }
+}
+
+float CpuIdle::busyShare(const Cpu& cpu, const std::vector<State>& states) {
+    if (cpu.windowNs <= 0) {
+        return NAN;
+    }
+    uint64_t idleUs = 0;
+    for (size_t s = cpu.first; s < cpu.first + cpu.count; ++s) {
+        idleUs += states[s].windowUs;
+    }
+    // Residency is accounted when a state is left, so a CPU idle across
+    // the end of a window can show more idle time than the window had.
+    return fmaxf(0.f, 1.f - idleUs * 1000.f / cpu.windowNs);
+}
+
+bool CpuIdle::totals(std::vector<CpuIdleTotal>* totals, std::vector<float>* busy) const {
+    std::lock_guard<std::mutex> _lock(mLock);
+    for (const auto& state : mStates) {
+        totals->push_back({state.cpu, state.name, state.timeUs, state.usage});
+    }
+    for (const auto& cpu : mCpus) {
+        busy->push_back(busyShare(cpu, mStates));
+    }
+    return !mStates.empty();
+}
+
+void CpuIdle::dump(int fd) const {
+    std::vector<Cpu> cpus;
+    std::vector<State> states;
+    {
+        std::lock_guard<std::mutex> _lock(mLock);
+        cpus = mCpus;
+        states.reserve(mStates.size());
+        for (const auto& state : mStates) {
+            states.push_back({state.cpu, state.name, {}, {}, {}, state.timeUs, state.usage,
+                              state.windowUs, state.windowUsage});
+        }
+    }
+
+    dprintf(fd, "  cpuidle over the last window:\n");
+    for (size_t c = 0; c < cpus.size(); ++c) {
+        const Cpu& cpu = cpus[c];
+        if (cpu.windowNs <= 0) {
+            dprintf(fd, "    cpu%zu: no window\n", c);
+            continue;
+        }
+        dprintf(fd, "    cpu%zu: busy %.1f%% of %" PRId64 " ms;", c,
+                100 * busyShare(cpu, states), cpu.windowNs / 1000000);
+        for (size_t s = cpu.first; s < cpu.first + cpu.count; ++s) {
+            const State& state = states[s];
+            dprintf(fd, " %s %.1f%% (%" PRIu64 "x)", state.name.c_str(),
+                    100. * state.windowUs * 1000 / cpu.windowNs, state.windowUsage);
+        }
+        dprintf(fd, "\n");
+    }
+}
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ANDROID_HARDWARE_THERMAL_V1_1_CPUIDLE_H
+#define ANDROID_HARDWARE_THERMAL_V1_1_CPUIDLE_H
+
+#include <stdint.h>
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <android-base/unique_fd.h>
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+// Cumulative counters of one idle state of one CPU, as the kernel keeps
+// them.
+struct CpuIdleTotal {
+    int cpu;
+    std::string state;
+    uint64_t timeUs;
+    uint64_t usage;
+};
+
+// Idle residency of every CPU from cpuidle, which unlike the jiffies in
+// /proc/stat is exact to the microsecond and tells shallow idle from deep.
+// The time and usage files of every state are opened once and read in one
+// batch per telemetry round of the watcher; each round then yields, per
+// CPU, the share of the window spent in each state and the busy share left
+// over. The files of a CPU are opened again after a read fails and when
+// the CPU comes back online, in case hotplug replaced them.
+class CpuIdle {
+  public:
+    CpuIdle() = default;
+    CpuIdle(const CpuIdle&) = delete;
+    CpuIdle& operator=(const CpuIdle&) = delete;
+
+    // Opens the idle states of cpu0, cpu1, ... under root until a CPU is
+    // missing. Returns false if no CPU has any.
+    bool open(const std::string& root);
+    bool isOpen() const { return !mStates.empty(); }
+
+    // Reads every state. The first round only sets the baseline. A CPU
+    // whose files cannot be read, typically because it is offline, has no
+    // window this round.
+    void sample(int64_t nowNs);
+    // Called on the uevent of cpu coming online; its files are opened again
+    // before the next round.
+    void setOnline(int cpu);
+
+    // Appends the counters of every state and, per CPU, the busy share of
+    // the last window or NAN if unknown.
+    bool totals(std::vector<CpuIdleTotal>* totals, std::vector<float>* busy) const;
+
+    void dump(int fd) const;
+
+  private:
+    struct State {
+        int cpu;
+        std::string name;
+        std::string dir;
+        ::android::base::unique_fd timeFd;
+        ::android::base::unique_fd usageFd;
+        uint64_t timeUs = 0;
+        uint64_t usage = 0;
+        // Over the last window; valid if the CPU's window is.
+        uint64_t windowUs = 0;
+        uint64_t windowUsage = 0;
+    };
+
+    struct Cpu {
+        // States of the CPU are mStates[first, first + count).
+        size_t first;
+        size_t count;
+        int64_t lastNs = 0;
+        int64_t windowNs = 0;
+    };
+
+    static float busyShare(const Cpu& cpu, const std::vector<State>& states);
+    bool openState(State* state);
+    bool readCpu(const Cpu& cpu, uint64_t* values);
+
+    // Grouped by CPU, shallowest state first.
+    std::vector<State> mStates;
+    std::vector<Cpu> mCpus;
+    // Scratch space of sample(), two counters per state and a flag per CPU.
+    std::vector<uint64_t> mValues;
+    std::vector<uint8_t> mValid;
+    // Per CPU, only used by the watcher thread: whether its files are to be
+    // opened again before the next read, and whether the last read failed.
+    std::vector<uint8_t> mReopen;
+    std::vector<uint8_t> mFailing;
+    mutable std::mutex mLock;
+};
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
+
+#endif  // ANDROID_HARDWARE_THERMAL_V1_1_CPUIDLE_H
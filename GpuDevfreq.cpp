@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "ThermalHAL"
+
+#include <ctype.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <memory>
+
+#include <android-base/file.h>
+#include <android-base/strings.h>
+#include <log/log.h>
+
+#include "GpuDevfreq.h"
+
+#define DEVFREQ_DIR             "/sys/class/devfreq"
+#define TRANS_STAT_BUF_SIZE     4096
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+// R-Car boards name the PowerVR device after its "gsx" node.
+static const char *kGpuNames[] = {"gpu", "gsx", "pvr", "sgx", "mali"};
+
+static bool isGpuName(const char *name) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    return std::any_of(std::begin(kGpuNames), std::end(kGpuNames), [&lower](const char *gpu) {
+        return lower.find(gpu) != std::string::npos;
+    });
+}
+
+static ::android::base::unique_fd openAttribute(const std::string& dir, const char *name) {
+    return ::android::base::unique_fd(
+            TEMP_FAILURE_RETRY(open((dir + "/" + name).c_str(), O_RDONLY | O_CLOEXEC)));
+}
+
+// Reads the number at the start of an attribute, which for load is the busy
+// percentage ahead of "@<freq>Hz".
+static bool readNumber(int fd, uint64_t* value) {
+    char buf[32];
+    const ssize_t len = fd < 0 ? -1 : TEMP_FAILURE_RETRY(pread(fd, buf, sizeof(buf) - 1, 0));
+    if (len <= 0) {
+        return false;
+    }
+    buf[len] = '\0';
+    char *end;
+    *value = strtoull(buf, &end, 10);
+    return end != buf;
+}
+
+bool GpuDevfreq::open(const std::string& dir, const std::string& root) {
+    mDir = dir;
+    if (mDir.empty()) {
+        const std::string classDir = root + DEVFREQ_DIR;
+        std::unique_ptr<DIR, int (*)(DIR*)> devfreq(opendir(classDir.c_str()), closedir);
+        struct dirent *de;
+        while (devfreq != nullptr && mDir.empty() && (de = readdir(devfreq.get()))) {
+            if (de->d_name[0] != '.' && isGpuName(de->d_name)) {
+                mDir = classDir + "/" + de->d_name;
+            }
+        }
+        if (mDir.empty()) {
+            return false;
+        }
+    }
+    mName = mDir.substr(mDir.find_last_of('/') + 1);
+
+    mCurFreqFd = openAttribute(mDir, "cur_freq");
+    if (mCurFreqFd < 0) {
+        ALOGE("%s: cannot read %s/cur_freq: %s", __func__, mDir.c_str(), strerror(errno));
+        return false;
+    }
+    mMaxFreqFd = openAttribute(mDir, "max_freq");
+    mLoadFd = openAttribute(mDir, "load");
+    mTransStatFd = openAttribute(mDir, "trans_stat");
+
+    std::string frequencies;
+    if (::android::base::ReadFileToString(mDir + "/available_frequencies", &frequencies)) {
+        for (const auto& token : ::android::base::Split(::android::base::Trim(frequencies), " ")) {
+            if (!token.empty()) {
+                mFrequencies.push_back(strtoull(token.c_str(), nullptr, 10));
+            }
+        }
+        std::sort(mFrequencies.begin(), mFrequencies.end());
+    }
+    ALOGI("%s: %s has %zu frequencies, %s", __func__, mName.c_str(), mFrequencies.size(),
+          mLoadFd >= 0 ? "load" : "no load");
+    return true;
+}
+
+bool GpuDevfreq::readTransStat(std::vector<uint64_t>* timeMs) {
+    char buf[TRANS_STAT_BUF_SIZE];
+    const ssize_t len = mTransStatFd < 0 ? -1 :
+            TEMP_FAILURE_RETRY(pread(mTransStatFd, buf, sizeof(buf) - 1, 0));
+    if (len <= 0 || mFrequencies.empty()) {
+        return false;
+    }
+    buf[len] = '\0';
+
+    // Rows look like "*  300000000:  0  5  1234": the current frequency is
+    // starred, then come the transition counts, and the time in ms last.
+    timeMs->assign(mFrequencies.size(), 0);
+    char *save;
+    for (char *line = strtok_r(buf, "\n", &save); line; line = strtok_r(nullptr, "\n", &save)) {
+        while (*line == ' ' || *line == '*') {
+            ++line;
+        }
+        char *end;
+        const uint64_t freq = strtoull(line, &end, 10);
+        if (end == line || *end != ':') {
+            continue;
+        }
+        const char *last = strrchr(end, ' ');
+        const auto it = std::lower_bound(mFrequencies.begin(), mFrequencies.end(), freq);
+        if (last != nullptr && it != mFrequencies.end() && *it == freq) {
+            (*timeMs)[it - mFrequencies.begin()] = strtoull(last + 1, nullptr, 10);
+        }
+    }
+    return true;
+}
+
+bool GpuDevfreq::sample(int64_t nowNs, Window* window) {
+    uint64_t freqHz;
+    if (!readNumber(mCurFreqFd, &freqHz)) {
+        return false;
+    }
+    uint64_t load = 0;
+    const bool hasLoad = readNumber(mLoadFd, &load);
+    uint64_t maxFreqHz = 0;
+    uint32_t coolingState = 0;
+    if (readNumber(mMaxFreqFd, &maxFreqHz)) {
+        coolingState = mFrequencies.end() -
+                std::upper_bound(mFrequencies.begin(), mFrequencies.end(), maxFreqHz);
+    }
+    std::vector<uint64_t> timeMs;
+    const bool hasTransStat = readTransStat(&timeMs);
+
+    const int64_t elapsedNs = mLastNs != 0 ? nowNs - mLastNs : 0;
+    mLastNs = nowNs;
+    uint64_t meanFreqHz = freqHz;
+    if (hasTransStat && mLastTimeMs.size() == timeMs.size()) {
+        double weighted = 0;
+        uint64_t total = 0;
+        for (size_t f = 0; f < timeMs.size(); ++f) {
+            const uint64_t delta = timeMs[f] - std::min(timeMs[f], mLastTimeMs[f]);
+            weighted += static_cast<double>(delta) * mFrequencies[f];
+            total += delta;
+        }
+        if (total > 0) {
+            meanFreqHz = weighted / total;
+        }
+    }
+    mLastTimeMs = std::move(timeMs);
+    if (elapsedNs <= 0) {
+        return false;
+    }
+
+    // load covers the driver's last polling interval, which is taken to
+    // hold for the whole window.
+    window->elapsedNs = elapsedNs;
+    window->busyNs =
+            hasLoad ? elapsedNs * static_cast<int64_t>(std::min<uint64_t>(load, 100)) / 100 : 0;
+    window->freqHz = freqHz;
+    window->meanFreqHz = meanFreqHz;
+    window->coolingState = coolingState;
+
+    std::lock_guard<std::mutex> _lock(mLock);
+    mLast = *window;
+    mTotalNs += window->elapsedNs;
+    mTotalBusyNs += window->busyNs;
+    return true;
+}
+
+void GpuDevfreq::dump(int fd) {
+    Window last;
+    int64_t totalNs, totalBusyNs;
+    {
+        std::lock_guard<std::mutex> _lock(mLock);
+        last = mLast;
+        totalNs = mTotalNs;
+        totalBusyNs = mTotalBusyNs;
+    }
+    dprintf(fd, "  GPU %s: %" PRIu64 " MHz, mean %" PRIu64 " MHz, cooling state %u\n",
+            mName.c_str(), last.freqHz / 1000000, last.meanFreqHz / 1000000,
+            last.coolingState);
+    if (mLoadFd < 0) {
+        dprintf(fd, "    utilization: unknown, no load file\n");
+    } else if (last.elapsedNs > 0 && totalNs > 0) {
+        dprintf(fd, "    estimated utilization: %.1f%% over %" PRId64 " ms, %.1f%% since start\n",
+                100. * last.busyNs / last.elapsedNs, last.elapsedNs / 1000000,
+                100. * totalBusyNs / totalNs);
+    }
+}
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
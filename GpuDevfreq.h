@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ANDROID_HARDWARE_THERMAL_V1_1_GPUDEVFREQ_H
+#define ANDROID_HARDWARE_THERMAL_V1_1_GPUDEVFREQ_H
+
+#include <stdint.h>
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <android-base/unique_fd.h>
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+// Load and frequency of the GPU from its devfreq device, read once per
+// telemetry round of the watcher through descriptors opened once. The
+// time spent at each frequency grows like CPU time in /proc/stat, so the
+// mean frequency of a window is exact. devfreq keeps no such counter of
+// busy time, though: the load file that some drivers provide holds the
+// busy share of the driver's last polling interval only, so busy time is
+// an estimate that takes that share to hold for the whole window. Without
+// a load file only the frequencies are known.
+class GpuDevfreq {
+  public:
+    struct Window {
+        int64_t elapsedNs;
+        // Estimated from the latest load reading, see above; zero if the
+        // device has no load file.
+        int64_t busyNs;
+        uint64_t freqHz;
+        // Time-weighted mean frequency over the window, from trans_stat.
+        uint64_t meanFreqHz;
+        // Frequencies above max_freq, counted like the devfreq cooling
+        // device counts its states.
+        uint32_t coolingState;
+    };
+
+    GpuDevfreq() = default;
+    GpuDevfreq(const GpuDevfreq&) = delete;
+    GpuDevfreq& operator=(const GpuDevfreq&) = delete;
+
+    // Uses the devfreq device in dir, or when dir is empty the first one in
+    // /sys/class/devfreq under root named like a GPU. Returns false if there
+    // is none.
+    bool open(const std::string& dir, const std::string& root = "");
+    bool isOpen() const { return mCurFreqFd >= 0; }
+    const std::string& name() const { return mName; }
+    bool hasLoad() const { return mLoadFd >= 0; }
+
+    // Reads one round; the first one only sets the baseline and returns
+    // false, as does a round in which cur_freq cannot be read.
+    bool sample(int64_t nowNs, Window* window);
+
+    void dump(int fd);
+
+  private:
+    bool readTransStat(std::vector<uint64_t>* timeMs);
+
+    std::string mName;
+    std::string mDir;
+    ::android::base::unique_fd mCurFreqFd;
+    ::android::base::unique_fd mMaxFreqFd;
+    ::android::base::unique_fd mLoadFd;
+    ::android::base::unique_fd mTransStatFd;
+    // Ascending; fixed for the life of the device, so read at open().
+    std::vector<uint64_t> mFrequencies;
+
+    int64_t mLastNs = 0;
+    // Milliseconds spent at each of mFrequencies, as of the last round.
+    std::vector<uint64_t> mLastTimeMs;
+
+    std::mutex mLock;
+    Window mLast = {};
+    int64_t mTotalNs = 0;
+    int64_t mTotalBusyNs = 0;
+};
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
+
+#endif  // ANDROID_HARDWARE_THERMAL_V1_1_GPUDEVFREQ_H
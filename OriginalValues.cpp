@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "ThermalHAL"
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <vector>
+
+#include <android-base/file.h>
+#include <android-base/strings.h>
+#include <log/log.h>
+
+#include "OriginalValues.h"
+
+#define BOOT_ID_FILE            "/proc/sys/kernel/random/boot_id"
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+void OriginalValues::open(const std::string& path) {
+    std::string bootId, content;
+    if (path.empty() || !::android::base::ReadFileToString(BOOT_ID_FILE, &bootId)) {
+        return;
+    }
+    mPath = path;
+    mBootId = ::android::base::Trim(bootId);
+    if (!::android::base::ReadFileToString(mPath, &content)) {
+        return;
+    }
+    // One "<file> <value>" line per file after the boot id.
+    const std::vector<std::string> lines = ::android::base::Split(content, "\n");
+    if (lines.empty() || lines[0] != mBootId) {
+        return;
+    }
+    for (size_t i = 1; i < lines.size(); ++i) {
+        const size_t space = lines[i].find(' ');
+        if (space != std::string::npos) {
+            mValues[lines[i].substr(0, space)] = lines[i].substr(space + 1);
+        }
+    }
+    ALOGI("%s: %zu values as found earlier in this boot", __func__, mValues.size());
+}
+
+std::string OriginalValues::keep(const std::string& file, const std::string& current) {
+    const auto inserted = mValues.emplace(file, current);
+    mDirty |= inserted.second;
+    return inserted.first->second;
+}
+
+void OriginalValues::forget(const std::string& dir) {
+    const std::string prefix = dir + "/";
+    for (auto it = mValues.lower_bound(prefix);
+         it != mValues.end() && ::android::base::StartsWith(it->first, prefix);) {
+        it = mValues.erase(it);
+        mDirty = true;
+    }
+}
+
+void OriginalValues::flush() {
+    if (!mDirty || mPath.empty()) {
+        return;
+    }
+    mDirty = false;
+    std::string content = mBootId + "\n";
+    for (const auto& value : mValues) {
+        content += value.first + " " + value.second + "\n";
+    }
+    // Replaced in one step so that a crash never leaves half a file.
+    const std::string tmpPath = mPath + ".tmp";
+    if (!::android::base::WriteStringToFile(content, tmpPath) ||
+        rename(tmpPath.c_str(), mPath.c_str()) != 0) {
+        ALOGE("%s: failed to write %s: %s", __func__, mPath.c_str(), strerror(errno));
+    }
+}
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
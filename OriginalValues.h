@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ANDROID_HARDWARE_THERMAL_V1_1_ORIGINALVALUES_H
+#define ANDROID_HARDWARE_THERMAL_V1_1_ORIGINALVALUES_H
+
+#include <map>
+#include <string>
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+// Values of sysfs files as they were before the HAL first wrote them in
+// this boot, kept in a file so that an instance restarted after a crash
+// restores those rather than what its predecessor left behind. The kernel
+// resets them on every boot, so values recorded in an earlier boot are
+// dropped. Not thread-safe; owned by the watcher thread.
+class OriginalValues {
+  public:
+    OriginalValues() = default;
+    OriginalValues(const OriginalValues&) = delete;
+    OriginalValues& operator=(const OriginalValues&) = delete;
+
+    // Loads the values recorded at path earlier in this boot. Without a
+    // path, values are only kept in memory.
+    void open(const std::string& path);
+
+    // Returns the value recorded for file, or records current and returns
+    // it if there is none.
+    std::string keep(const std::string& file, const std::string& current);
+    // Drops the values of every file under dir, whose device is gone.
+    void forget(const std::string& dir);
+    // Writes the values out if any changed since the last call.
+    void flush();
+
+  private:
+    std::string mPath;
+    std::string mBootId;
+    std::map<std::string, std::string> mValues;
+    bool mDirty = false;
+};
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
+
+#endif  // ANDROID_HARDWARE_THERMAL_V1_1_ORIGINALVALUES_H
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "ThermalHAL"
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include <algorithm>
+
+#include "SeverityEngine.h"
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+const char *toString(SeverityLevel level) {
+    switch (level) {
+        case SeverityLevel::NONE:
+            return "NONE";
+        case SeverityLevel::LIGHT:
+            return "LIGHT";
+        case SeverityLevel::MODERATE:
+            return "MODERATE";
+        case SeverityLevel::SEVERE:
+            return "SEVERE";
+        case SeverityLevel::CRITICAL:
+            return "CRITICAL";
+        case SeverityLevel::EMERGENCY:
+            return "EMERGENCY";
+    }
+    return "UNKNOWN";
+}
+
+size_t SeverityEngine::addZone(const SeverityThresholds& hot, const SeverityThresholds& cold) {
+    std::lock_guard<std::mutex> _lock(mLock);
+    for (size_t l = 0; l < kNumSeverityLevels; ++l) {
+        mHot[l].push_back(hot[l]);
+        mCold[l].push_back(cold[l]);
+    }
+    mLevels.push_back(0);
+    mNextLevels.push_back(0);
+    return mLevels.size() - 1;
+}
+
+void SeverityEngine::setThresholds(size_t zone, const SeverityThresholds& hot,
+                                   const SeverityThresholds& cold) {
+    std::lock_guard<std::mutex> _lock(mLock);
+    for (size_t l = 0; l < kNumSeverityLevels; ++l) {
+        mHot[l][zone] = hot[l];
+        mCold[l][zone] = cold[l];
+    }
+}
+
+void SeverityEngine::restoreLevel(size_t zone, SeverityLevel level) {
+    std::lock_guard<std::mutex> _lock(mLock);
+    if (zone >= mLevels.size()) {
+        return;
+    }
+    mLevels[zone] = static_cast<uint8_t>(level);
+    mMaxLevel = *std::max_element(mLevels.begin(), mLevels.end());
+}
+
+bool SeverityEngine::evaluate(const float *temperatures, int64_t nowNs,
+                              std::vector<Transition>* transitions) {
+    std::lock_guard<std::mutex> _lock(mLock);
+    const size_t n = mLevels.size();
+    const uint8_t *levels = mLevels.data();
+    uint8_t *next = mNextLevels.data();
+    const float *hot[kNumSeverityLevels];
+    const float *cold[kNumSeverityLevels];
+    for (size_t l = 0; l < kNumSeverityLevels; ++l) {
+        hot[l] = mHot[l].data();
+        cold[l] = mCold[l].data();
+    }
+
+    // One pass over the zones; the loop over levels has a fixed trip count
+    // and unrolls. Comparisons against NAN are false, so unused levels and
+    // unread zones never become active.
+    uint8_t maxLevel = 0;
+    for (size_t z = 0; z < n; ++z) {
+        const float temperature = temperatures[z];
+        uint8_t level = 0;
+        for (uint8_t l = 1; l < kNumSeverityLevels; ++l) {
+            const uint8_t active = (temperature >= hot[l][z]) |
+                                   ((levels[z] >= l) & (temperature > cold[l][z]));
+            level = std::max<uint8_t>(level, active * l);
+        }
+        next[z] = level;
+        maxLevel = std::max(maxLevel, level);
+        if (level != levels[z]) {
+            transitions->push_back({z, static_cast<SeverityLevel>(levels[z]),
+                                    static_cast<SeverityLevel>(level)});
+        }
+    }
+    mLevels.swap(mNextLevels);
+
+    if (mLastNs != 0) {
+        mResidencyNs[mMaxLevel] += nowNs - mLastNs;
+    }
+    mLastNs = nowNs;
+    if (maxLevel == mMaxLevel) {
+        return false;
+    }
+    mMaxLevel = maxLevel;
+    ++mEntries[maxLevel];
+    return true;
+}
+
+SeverityLevel SeverityEngine::level(size_t zone) const {
+    std::lock_guard<std::mutex> _lock(mLock);
+    return static_cast<SeverityLevel>(mLevels[zone]);
+}
+
+SeverityLevel SeverityEngine::maxLevel() const {
+    std::lock_guard<std::mutex> _lock(mLock);
+    return static_cast<SeverityLevel>(mMaxLevel);
+}
+
+float SeverityEngine::hotThreshold(size_t zone, SeverityLevel level) const {
+    std::lock_guard<std::mutex> _lock(mLock);
+    return mHot[static_cast<size_t>(level)][zone];
+}
+
+float SeverityEngine::coldThreshold(size_t zone, SeverityLevel level) const {
+    std::lock_guard<std::mutex> _lock(mLock);
+    return mCold[static_cast<size_t>(level)][zone];
+}
+
+void SeverityEngine::dump(int fd, const std::vector<std::string>& zoneNames) {
+    uint8_t maxLevel;
+    std::array<int64_t, kNumSeverityLevels> residencyNs;
+    std::array<uint64_t, kNumSeverityLevels> entries;
+    std::vector<uint8_t> levels;
+    std::array<std::vector<float>, kNumSeverityLevels> hot, cold;
+    {
+        std::lock_guard<std::mutex> _lock(mLock);
+        maxLevel = mMaxLevel;
+        residencyNs = mResidencyNs;
+        entries = mEntries;
+        levels = mLevels;
+        hot = mHot;
+        cold = mCold;
+    }
+
+    dprintf(fd, "SeverityEngine:\n");
+    dprintf(fd, "  device level: %s\n", toString(static_cast<SeverityLevel>(maxLevel)));
+    for (size_t l = 0; l < kNumSeverityLevels; ++l) {
+        dprintf(fd, "  %-9s entries %" PRIu64 ", residency %" PRId64 " ms\n",
+                toString(static_cast<SeverityLevel>(l)), entries[l], residencyNs[l] / 1000000);
+    }
+    for (size_t z = 0; z < levels.size() && z < zoneNames.size(); ++z) {
+        dprintf(fd, "  %s: %s hot/cold", zoneNames[z].c_str(),
+                toString(static_cast<SeverityLevel>(levels[z])));
+        for (size_t l = 1; l < kNumSeverityLevels; ++l) {
+            dprintf(fd, " %.1f/%.1f", hot[l][z], cold[l][z]);
+        }
+        dprintf(fd, "\n");
+    }
+}
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
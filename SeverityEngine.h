@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ANDROID_HARDWARE_THERMAL_V1_1_SEVERITYENGINE_H
+#define ANDROID_HARDWARE_THERMAL_V1_1_SEVERITYENGINE_H
+
+#include <stdint.h>
+
+#include <array>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+enum class SeverityLevel : uint8_t {
+    NONE = 0,
+    LIGHT,
+    MODERATE,
+    SEVERE,
+    CRITICAL,
+    EMERGENCY,
+};
+
+constexpr size_t kNumSeverityLevels = static_cast<size_t>(SeverityLevel::EMERGENCY) + 1;
+
+// Thresholds in degrees Celsius indexed by SeverityLevel; index 0 is unused
+// and NAN disables a level.
+using SeverityThresholds = std::array<float, kNumSeverityLevels>;
+
+const char *toString(SeverityLevel level);
+
+// Evaluates the severity level of every zone from one temperature sample.
+// A zone enters a level when it reaches the level's hot threshold and leaves
+// it when it falls to or below the cold threshold.
+class SeverityEngine {
+  public:
+    struct Transition {
+        size_t zone;
+        SeverityLevel from;
+        SeverityLevel to;
+    };
+
+    // Returns the index of the new zone.
+    size_t addZone(const SeverityThresholds& hot, const SeverityThresholds& cold);
+    void setThresholds(size_t zone, const SeverityThresholds& hot, const SeverityThresholds& cold);
+    // Resumes a zone at a level left by a previous run without reporting a
+    // transition. Zones the engine does not have are ignored.
+    void restoreLevel(size_t zone, SeverityLevel level);
+
+    // temperatures holds one value per zone; NAN leaves a zone at NONE.
+    // Transitions are appended to *transitions. Returns true when the device
+    // wide maximum level changed.
+    bool evaluate(const float *temperatures, int64_t nowNs, std::vector<Transition>* transitions);
+
+    size_t size() const { return mLevels.size(); }
+    SeverityLevel level(size_t zone) const;
+    SeverityLevel maxLevel() const;
+    // Raw per-zone levels; only valid on the thread that calls evaluate().
+    const uint8_t *levelData() const { return mLevels.data(); }
+    float hotThreshold(size_t zone, SeverityLevel level) const;
+    float coldThreshold(size_t zone, SeverityLevel level) const;
+
+    void dump(int fd, const std::vector<std::string>& zoneNames);
+
+  private:
+    // Structure of arrays: mHot[level][zone].
+    std::array<std::vector<float>, kNumSeverityLevels> mHot;
+    std::array<std::vector<float>, kNumSeverityLevels> mCold;
+    std::vector<uint8_t> mLevels;
+    std::vector<uint8_t> mNextLevels;
+
+    mutable std::mutex mLock;
+    uint8_t mMaxLevel = 0;
+    int64_t mLastNs = 0;
+    std::array<int64_t, kNumSeverityLevels> mResidencyNs{};
+    std::array<uint64_t, kNumSeverityLevels> mEntries{};
+};
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
+
+#endif  // ANDROID_HARDWARE_THERMAL_V1_1_SEVERITYENGINE_H
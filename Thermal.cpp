@@ -17,25 +17,48 @@
 #define LOG_TAG "ThermalHAL"
 
 #include <errno.h>
+#include <fcntl.h>
 #include <math.h>
 #include <vector>
 #include <log/log.h>
 #include <hardware/hardware.h>
 #include <hardware/thermal.h>
 #include <inttypes.h>
+#include <sched.h>
+#include <unistd.h>
+#include <android-base/file.h>
+#include <android-base/parseint.h>
+#include <android-base/properties.h>
+#include <android-base/strings.h>
+#include <cutils/sockets.h>
+#include <utils/SystemClock.h>
+
+#include <algorithm>
+#include <future>
 
 #include "Thermal.h"
 
-#define MAX_LENGTH              50
-#define TEMP_NAME_LENGTH        15
-
 #define CPU_USAGE_FILE          "/proc/stat"
-#define TEMPERATURE_DIR         "/sys/class/thermal"
-#define THERMAL_DIR             "thermal_zone"
-#define CPU_ONLINE_FILE_FORMAT  "/sys/devices/system/cpu/cpu%d/online"
+#define CPU_USAGE_BUF_SIZE      1024
 #define UNKNOWN_LABEL           "UNKNOWN"
 #define THROTTLING_THRESHOLD    100
 #define SHUTDOWN_THRESHOLD      120
+#define THRESHOLD_HYSTERESIS    2
+#define CONFIG_FILE             "/vendor/etc/thermal-renesas.conf"
+#define SNAPSHOT_FILE           "/data/vendor/thermal/snapshot"
+#define JOURNAL_FILE            "/data/vendor/thermal/journal"
+#define ORIGINALS_FILE          "/data/vendor/thermal/originals"
+#define TRIP_WINDOW_PROPERTY    "vendor.thermal.trip_window"
+#define RT_PRIORITY_PROPERTY    "vendor.thermal.rt_priority"
+#define CPU_AFFINITY_PROPERTY   "vendor.thermal.cpus"
+#define MLOCK_PROPERTY          "vendor.thermal.mlock"
+#define TRACE_PROPERTY          "vendor.thermal.trace"
+#define TIMELINE_PROPERTY       "vendor.thermal.timeline"
+#define METRICS_PROPERTY        "vendor.thermal.metrics"
+#define METRICS_SOCKET          "thermal_metrics"
+#define TUNING_PROPERTY         "vendor.thermal.profile"
+#define DEBUGGABLE_PROPERTY     "ro.debuggable"
+#define MAX_RT_PRIORITY         99
 
 
 namespace android {
@@ -45,66 +68,349 @@ namespace V1_1 {
 namespace renesas {
 
 sp<IThermalCallback> Thermal::sThermalCb;
+std::mutex Thermal::sThermalCbLock;
 
 static float finalizeTemperature(float temperature) {
     return (temperature == UNKNOWN_TEMPERATURE) ? NAN : temperature;
 }
 
-Thermal::Thermal() {}
+static ZoneConfig defaultZoneConfig() {
+    ZoneConfig config;
+    config.hot.fill(NAN);
+    config.cold.fill(NAN);
+    config.hot[static_cast<size_t>(SeverityLevel::SEVERE)] = THROTTLING_THRESHOLD;
+    config.cold[static_cast<size_t>(SeverityLevel::SEVERE)] =
+            THROTTLING_THRESHOLD - THRESHOLD_HYSTERESIS;
+    config.hot[static_cast<size_t>(SeverityLevel::EMERGENCY)] = SHUTDOWN_THRESHOLD;
+    config.cold[static_cast<size_t>(SeverityLevel::EMERGENCY)] =
+            SHUTDOWN_THRESHOLD - THRESHOLD_HYSTERESIS;
+    return config;
+}
+
+// Parses a CPU list such as "4-7" or "0,2". Returns false on malformed input.
+static bool parseCpuList(const std::string& list, std::vector<int>* cpus) {
+    for (const auto& range : android::base::Split(list, ",")) {
+        const auto bounds = android::base::Split(android::base::Trim(range), "-");
+        int first, last;
+        if (bounds.size() > 2 || !android::base::ParseInt(bounds[0], &first, 0, CPU_SETSIZE - 1) ||
+            !android::base::ParseInt(bounds.back(), &last, first, CPU_SETSIZE - 1)) {
+            return false;
+        }
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus->push_back(cpu);
+        }
+    }
+    return true;
+}
+
+static ThermalWatcher::SchedulingPolicy schedulingPolicy() {
+    ThermalWatcher::SchedulingPolicy policy;
+    policy.rtPriority = android::base::GetIntProperty(RT_PRIORITY_PROPERTY, 0, 0, MAX_RT_PRIORITY);
+    policy.lockMemory = android::base::GetBoolProperty(MLOCK_PROPERTY, false);
+    const std::string cpus = android::base::GetProperty(CPU_AFFINITY_PROPERTY, "");
+    if (!cpus.empty() && !parseCpuList(cpus, &policy.cpus)) {
+        ALOGE("%s: ignoring malformed %s: %s", __func__, CPU_AFFINITY_PROPERTY, cpus.c_str());
+        policy.cpus.clear();
+    }
+    return policy;
+}
+
+// A file of the HAL under the root set by ThermalWatcher::setRootDir().
+static std::string path(const char *file) {
+    return ThermalWatcher::rootDir() + file;
+}
+
+// Reads when the process was started from /proc/self/stat, in boot clock
+// nanoseconds. Returns 0 if it cannot be read.
+static int64_t processStartNs() {
+    std::string stat;
+    if (!android::base::ReadFileToString("/proc/self/stat", &stat)) {
+        return 0;
+    }
+    // The command name may contain spaces; field 22 (starttime) is the 20th
+    // field after it.
+    const auto fields = android::base::Split(stat.substr(stat.rfind(')') + 2), " ");
+    uint64_t ticks;
+    if (fields.size() < 20 || !android::base::ParseUint(fields[19], &ticks)) {
+        return 0;
+    }
+    return ticks * (1000000000LL / sysconf(_SC_CLK_TCK));
+}
+
+Thermal::Thermal(bool passive)
+    : mPassive(passive), mConfig(defaultZoneConfig()), mProcessStartNs(processStartNs()) {
+    mStatFd.reset(TEMP_FAILURE_RETRY(open(path(CPU_USAGE_FILE).c_str(), O_RDONLY | O_CLOEXEC)));
+    if (mStatFd < 0) {
+        ALOGE("%s: failed to open %s: %s", __func__, CPU_USAGE_FILE, strerror(errno));
+    }
+    if (mPassive) {
+        startPassive();
+        return;
+    }
+
+    auto journalOpened = std::async(std::launch::async, [this] {
+        return mJournal.open(path(JOURNAL_FILE));
+    });
+
+    mTimeline.setEnabled(android::base::GetBoolProperty(TIMELINE_PROPERTY, false));
+    mWatcher = new ThermalWatcher(mConfig, mSnapshot, mJournal, mTimeline,
+            [this](const std::string& name, float temperature, SeverityLevel /* from */,
+                   SeverityLevel to) {
+                notifyThrottling(name, temperature, to);
+            });
+    const ThermalWatcher::SchedulingPolicy policy = schedulingPolicy();
+    mWatcher->setSchedulingPolicy(policy);
+    const std::string tracePath = android::base::GetProperty(TRACE_PROPERTY, "");
+    if (!tracePath.empty() && mTrace.open(tracePath)) {
+        ALOGI("%s: recording sensor reads to %s", __func__, tracePath.c_str());
+        mWatcher->setTraceWriter(&mTrace);
+    }
+    mWatcher->setOriginalsPath(path(ORIGINALS_FILE));
+#ifdef THERMAL_LAZY_HAL
+    // The process can exit whenever it has no clients and must not leave
+    // moved trip points behind.
+    const bool useTripWindow = false;
+#else
+    const bool useTripWindow = android::base::GetBoolProperty(TRIP_WINDOW_PROPERTY, true);
+#endif
+#ifdef THERMAL_BOARD
+    bool discovered = useBoardProfile(boards::THERMAL_BOARD, policy);
+#else
+    bool discovered = false;
+#endif
+    if (!discovered) {
+        // Reading the configuration overlaps with zone discovery; only
+        // applying it to the zones has to wait for it.
+        auto configLoaded = std::async(std::launch::async, [this] {
+            return mConfig.load(path(CONFIG_FILE));
+        });
+        discovered = mWatcher->discover(useTripWindow);
+        if (!configLoaded.get()) {
+            ALOGI("%s: %s not found, using default thresholds", __func__, CONFIG_FILE);
+        }
+    }
+    if (!journalOpened.get()) {
+        ALOGW("%s: thermal events will not persist", __func__);
+    }
+    if (!discovered || !mWatcher->startWatching(path(SNAPSHOT_FILE))) {
+        ALOGE("%s: failed to start thermal watcher", __func__);
+    } else {
+        mTuning = new ThermalTuning(mConfig, *mWatcher);
+        if (!mTuning->startWatchingProperty(TUNING_PROPERTY)) {
+            ALOGE("%s: failed to watch %s", __func__, TUNING_PROPERTY);
+        }
+    }
+    mDiscoveredNs = elapsedRealtimeNano();
+
+    if (android::base::GetBoolProperty(METRICS_PROPERTY, false)) {
+        // init creates the socket, see the service's rc file.
+        const int socketFd = android_get_control_socket(METRICS_SOCKET);
+        mMetrics = new ThermalMetrics(mSnapshot);
+        if (socketFd < 0 ||
+            !mMetrics->startServing(
+                    socketFd,
+                    [this](std::vector<CpuUsage>* cpuUsages) {
+                        return readCpuUsages(cpuUsages);
+                    },
+                    [this](std::vector<CpuIdleTotal>* totals, std::vector<float>* busy) {
+                        return mWatcher->cpuIdle().totals(totals, busy);
+                    })) {
+            ALOGE("%s: failed to serve metrics on %s", __func__, METRICS_SOCKET);
+            mMetrics.clear();
+        }
+    }
+}
+
+void Thermal::startPassive() {
+    mWatcher = new ThermalWatcher(mConfig, mSnapshot, mJournal, mTimeline,
+            [](const std::string& /* name */, float /* temperature */, SeverityLevel /* from */,
+               SeverityLevel /* to */) {});
+#ifdef THERMAL_BOARD
+    bool discovered = useBoardProfile(boards::THERMAL_BOARD, {});
+#else
+    bool discovered = false;
+#endif
+    if (!discovered) {
+        mConfig.load(path(CONFIG_FILE));
+        discovered = mWatcher->discover(false);
+    }
+    if (!discovered || !mWatcher->publishZones()) {
+        ALOGE("%s: no thermal zones", __func__);
+    }
+    mDiscoveredNs = elapsedRealtimeNano();
+}
+
+template <size_t Zones, size_t Clusters, size_t Actuators>
+bool Thermal::useBoardProfile(const BoardProfile<Zones, Clusters, Actuators>& profile,
+                              ThermalWatcher::SchedulingPolicy policy) {
+    if (!mWatcher->discover(profile.zones.data(), Zones)) {
+        ALOGW("%s: board is not %s, discovering zones", __func__, profile.name);
+        return false;
+    }
+    for (const auto& zone : profile.zones) {
+        ZoneConfig config;
+        config.hot = zone.hot;
+        config.cold = zone.cold;
+        config.periodMs = zone.periodMs;
+        mConfig.set(zone.type, config);
+    }
+    for (const auto& cluster : profile.clusters) {
+        if (cluster.little && policy.cpus.empty()) {
+            for (int cpu = cluster.firstCpu; cpu <= cluster.lastCpu; ++cpu) {
+                policy.cpus.push_back(cpu);
+            }
+            mWatcher->setSchedulingPolicy(policy);
+        }
+    }
+    mWatcher->setActuators(profile.actuators.data(), Actuators);
+    ALOGI("%s: using the %s board profile", __func__, profile.name);
+    return true;
+}
+
+void Thermal::markRegistered() {
+    mRegisteredNs = elapsedRealtimeNano();
+}
+
+void Thermal::markCall(int64_t nowNs) {
+    int64_t expected = 0;
+    mFirstCallNs.compare_exchange_strong(expected, nowNs);
+}
+
+Thermal::CallScope::CallScope(Thermal* thermal, ThermalMetrics::Call call)
+    : mThermal(thermal), mCall(call), mStartNs(elapsedRealtimeNano()) {
+    mThermal->markCall(mStartNs);
+}
+
+Thermal::CallScope::~CallScope() {
+    if (mThermal->mMetrics == nullptr && !mThermal->mTimeline.enabled()) {
+        return;
+    }
+    const int64_t endNs = elapsedRealtimeNano();
+    if (mThermal->mMetrics != nullptr) {
+        mThermal->mMetrics->recordCall(mCall, endNs - mStartNs);
+    }
+    if (mThermal->mTimeline.enabled()) {
+        mThermal->mTimeline.slice(ThermalMetrics::callName(mCall), mStartNs, endNs);
+    }
+}
+
+static V1_0::TemperatureType temperatureType(ZoneClass zoneClass) {
+    switch (zoneClass) {
+        case ZoneClass::CPU:
+            return V1_0::TemperatureType::CPU;
+        case ZoneClass::GPU:
+            return V1_0::TemperatureType::GPU;
+        case ZoneClass::BATTERY:
+            return V1_0::TemperatureType::BATTERY;
+        case ZoneClass::SKIN:
+            return V1_0::TemperatureType::SKIN;
+        default:
+            return V1_0::TemperatureType::UNKNOWN;
+    }
+}
+
+Temperature Thermal::makeTemperature(const std::string& name, float temperature,
+                                     ZoneClass zoneClass) const {
+    // The 1.x types only know one throttling threshold: report the first
+    // configured level as throttling and the last one as shutdown.
+    const ZoneConfig& config = mConfig.zone(name);
+    float throttlingThreshold = NAN;
+    for (size_t l = 1; l < kNumSeverityLevels && isnan(throttlingThreshold); ++l) {
+        throttlingThreshold = config.hot[l];
+    }
+
+    Temperature t;
+    t.type = temperatureType(zoneClass);
+    t.name = name;
+    t.currentValue = temperature;
+    t.throttlingThreshold = throttlingThreshold;
+    t.shutdownThreshold = config.hot[static_cast<size_t>(SeverityLevel::EMERGENCY)];
+    t.vrThrottlingThreshold = finalizeTemperature(UNKNOWN_TEMPERATURE);
+    return t;
+}
+
+void Thermal::notifyThrottling(const std::string& name, float temperature, SeverityLevel level) {
+    // The table knows power supplies, which are battery whatever their name.
+    ZoneClass zoneClass = classifyZone(name);
+    const auto table = mWatcher->zoneTable();
+    if (table != nullptr) {
+        auto it = table->byName.find(name);
+        if (it != table->byName.end() && !it->second.empty()) {
+            zoneClass = table->zones[it->second.front()].zoneClass;
+        }
+    }
+    sp<IThermalCallback> callback;
+    {
+        std::lock_guard<std::mutex> _lock(sThermalCbLock);
+        callback = sThermalCb;
+    }
+    if (callback != nullptr) {
+        const Temperature t = makeTemperature(name, temperature, zoneClass);
+        if (!callback->notifyThrottling(level != SeverityLevel::NONE, t).isOk()) {
+            ALOGE("%s: failed to notify throttling of %s", __func__, name.c_str());
+        }
+    }
+
+    // Filtering here means a client only interested in, say, the battery
+    // costs nothing when a CPU zone changes level.
+    std::vector<Notifier> notifiers;
+    {
+        std::lock_guard<std::mutex> _lock(mNotifierLock);
+        for (const auto& notifier : mNotifiers) {
+            if (!notifier.filterClass || notifier.zoneClass == zoneClass) {
+                notifiers.push_back(notifier);
+            }
+        }
+    }
+    for (const auto& notifier : notifiers) {
+        if (!notifier.notify(name, zoneClass, temperature, level)) {
+            removeThrottlingNotifier(notifier.id);
+        }
+    }
+}
+
+uint32_t Thermal::addThrottlingNotifier(const ZoneClass *zoneClass,
+                                        const ThrottlingNotifier& notifier) {
+    std::lock_guard<std::mutex> _lock(mNotifierLock);
+    const uint32_t id = mNextNotifierId++;
+    mNotifiers.push_back({id, zoneClass != nullptr,
+                          zoneClass != nullptr ? *zoneClass : ZoneClass::UNKNOWN, notifier});
+    return id;
+}
+
+void Thermal::removeThrottlingNotifier(uint32_t id) {
+    std::lock_guard<std::mutex> _lock(mNotifierLock);
+    mNotifiers.erase(std::remove_if(mNotifiers.begin(), mNotifiers.end(),
+                                    [id](const Notifier& n) { return n.id == id; }),
+                     mNotifiers.end());
+}
 
 // Methods from ::android::hardware::thermal::V1_1::IThermal follow.
 Return<void> Thermal::getTemperatures(getTemperatures_cb _hidl_cb) {
+    CallScope scope(this, ThermalMetrics::GET_TEMPERATURES);
     ThermalStatus status;
     status.code = V1_0::ThermalStatusCode::SUCCESS;
     hidl_vec<Temperature> temperatures_reply;
     std::vector<Temperature> temperatures;
 
-    char file_name[MAX_LENGTH];
-    FILE *file;
-    float temp = 0.f;
-    char name [TEMP_NAME_LENGTH] = {0};
-    DIR *dir;
-    struct dirent *de;
-
-    dir = opendir(TEMPERATURE_DIR);
-    if (dir == nullptr) {
-        ALOGE("%s: failed to open directory %s: %s", __func__, TEMPERATURE_DIR, strerror(-errno));
+    // The watcher keeps the zone table current as zones come and go, so
+    // there is no directory scan here.
+    const auto table = mWatcher->zoneTable();
+    if (table == nullptr) {
+        ALOGE("%s: no thermal zones", __func__);
         status.code = V1_0::ThermalStatusCode::FAILURE;
         _hidl_cb(status, temperatures);
         return Void();
     }
 
-    while ((de = readdir(dir))) {
-        if (!strncmp(de->d_name, THERMAL_DIR, strlen(THERMAL_DIR))) {
-            snprintf(file_name, MAX_LENGTH, "%s/%s/temp", TEMPERATURE_DIR, de->d_name);
-            file = fopen(file_name, "r");
-            if (file == nullptr) {
-                continue;
-            }
-            if (1 != fscanf(file, "%f", &temp)) {
-                fclose(file);
-                continue;
-            }
-
-            fclose(file);
-            snprintf(file_name, MAX_LENGTH, "%s/%s/type", TEMPERATURE_DIR, de->d_name);
-            file = fopen(file_name, "r");
-            if (1 != fscanf(file, "%s", name)) {
-                fclose(file);
-                continue;
-            }
-
-            Temperature temperature;
-            temperature.type = V1_0::TemperatureType::CPU;
-            temperature.name = std::string(name);
-            temperature.currentValue = temp / 1000.f;
-            temperature.throttlingThreshold = finalizeTemperature(THROTTLING_THRESHOLD);
-            temperature.shutdownThreshold = finalizeTemperature(SHUTDOWN_THRESHOLD);
-            temperature.vrThrottlingThreshold = finalizeTemperature(UNKNOWN_TEMPERATURE);
-
-            temperatures.push_back(temperature);
-
+    temperatures.reserve(table->zones.size());
+    for (const auto& zone : table->zones) {
+        float temp;
+        if (zone.tempFd == nullptr ||
+            !ThermalWatcher::readTemperature(*zone.tempFd, zone.unit, &temp)) {
+            continue;
         }
+        temperatures.push_back(makeTemperature(zone.name, temp, zone.zoneClass));
     }
 
     if (temperatures.size() == 0) {
@@ -116,83 +422,131 @@ Return<void> Thermal::getTemperatures(getTemperatures_cb _hidl_cb) {
     return Void();
 }
 
+void Thermal::readZones(const ThermalWatcher::ZoneTable& table, const std::vector<size_t>& zones,
+                        bool cached, std::vector<ZoneReading>* readings) {
+    readings->reserve(readings->size() + zones.size());
+    // Nothing samples the zones of a passive HAL.
+    cached &= !mPassive;
+    for (size_t index : zones) {
+        const auto& zone = table.zones[index];
+        float temp;
+        if (cached) {
+            temp = mSnapshot.temperature(index);
+            if (isnan(temp)) {
+                continue;
+            }
+        } else if (zone.tempFd == nullptr ||
+                   !ThermalWatcher::readTemperature(*zone.tempFd, zone.unit, &temp)) {
+            continue;
+        }
+        readings->push_back({index, temp});
+    }
+}
+
+bool Thermal::readCpuUsages(std::vector<CpuUsage>* cpuUsages) {
+    if (mStatFd < 0) {
+        return false;
+    }
+
+    // The per-CPU lines come first in /proc/stat, so reading stops at the
+    // first line after them rather than having the kernel format the whole
+    // file, and the lines are parsed in place.
+    // Sized like the last reply so that the vector does not grow line by
+    // line.
+    cpuUsages->reserve(cpuUsages->size() + mCpuLines.load(std::memory_order_relaxed));
+    const size_t first = cpuUsages->size();
+    const bool tracing = mTrace.isOpen();
+    char buf[CPU_USAGE_BUF_SIZE];
+    size_t len = 0;
+    off_t offset = 0;
+    bool done = false;
+    bool ok = true;
+    while (!done) {
+        ssize_t read = TEMP_FAILURE_RETRY(
+                pread(mStatFd, buf + len, sizeof(buf) - 1 - len, offset));
+        if (read <= 0) {
+            break;
+        }
+        offset += read;
+        len += read;
+        buf[len] = '\0';
+
+        char *line = buf;
+        while (!done) {
+            const size_t remaining = buf + len - line;
+            if (remaining >= 3 && strncmp(line, "cpu", 3) != 0) {
+                done = true;
+                break;
+            }
+            char *end = static_cast<char *>(memchr(line, '\n', remaining));
+            if (end == nullptr) {
+                break;
+            }
+            *end = '\0';
+
+            // Skip the aggregate "cpu " line.
+            if (isdigit(line[3])) {
+                int cpu_num;
+                uint64_t user, nice, system, idle;
+                int vals = sscanf(line, "cpu%d %" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64,
+                                  &cpu_num, &user, &nice, &system, &idle);
+                if (vals != 5) {
+                    ALOGE("%s: failed to read CPU information from file: %s", __func__,
+                          strerror(errno));
+                    ok = false;
+                    done = true;
+                    break;
+                }
+
+                char cpu_name[16];
+                snprintf(cpu_name, sizeof(cpu_name), "CPU%d", cpu_num);
+
+                CpuUsage usage;
+                usage.name = cpu_name;
+                usage.active = user + nice + system;
+                usage.total = usage.active + idle;
+                usage.isOnline = mWatcher->isCpuOnline(cpu_num);
+                cpuUsages->push_back(usage);
+                if (tracing) {
+                    mTrace.cpuRead(elapsedRealtimeNano(), cpu_num, usage.active, usage.total);
+                }
+            }
+            line = end + 1;
+        }
+
+        len -= line - buf;
+        memmove(buf, line, len);
+        // A line that does not fit cannot be a CPU line.
+        done |= len == sizeof(buf) - 1;
+    }
+    if (tracing) {
+        mTrace.flush();
+    }
+    mCpuLines.store(cpuUsages->size() - first, std::memory_order_relaxed);
+    return ok;
+}
+
 Return<void> Thermal::getCpuUsages(getCpuUsages_cb _hidl_cb) {
+    CallScope scope(this, ThermalMetrics::GET_CPU_USAGES);
     ThermalStatus status;
     hidl_vec<CpuUsage> cpuUsages_reply;
     std::vector<CpuUsage> cpuUsages;
     status.code = V1_0::ThermalStatusCode::SUCCESS;
 
-    int vals, cpu_num, online = 0;
-    ssize_t read;
-    uint64_t user, nice, system, idle, active, total;
-    char *line = nullptr;
-    size_t len = 0;
-    char file_name[MAX_LENGTH];
-    char cpu_name[5];
-    FILE *cpu_file;
-    FILE *file = fopen(CPU_USAGE_FILE, "r");
-
-    if (file == nullptr) {
-        ALOGE("%s: failed to open: %s", __func__, strerror(errno));
-         _hidl_cb(status, cpuUsages);
+    if (mStatFd < 0) {
+        ALOGE("%s: %s is not open", __func__, CPU_USAGE_FILE);
+        _hidl_cb(status, cpuUsages);
         return Void();
     }
 
-    while ((read = getline(&line, &len, file)) != -1) {
-        // Skip non "cpu[0-9]" lines.
-        if (strnlen(line, read) < 4 || strncmp(line, "cpu", 3) != 0 || !isdigit(line[3])) {
-            free(line);
-            line = nullptr;
-            len = 0;
-            continue;
-        }
-        vals = sscanf(line, "cpu%d %" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64, &cpu_num, &user,
-                &nice, &system, &idle);
-
-        free(line);
-        line = nullptr;
-        len = 0;
-
-        if (vals != 5) {
-            ALOGE("%s: failed to read CPU information from file: %s", __func__, strerror(errno));
-            fclose(file);
-            status.code = V1_0::ThermalStatusCode::FAILURE;
-            status.debugMessage = strerror(-EIO);
-            _hidl_cb(status, cpuUsages);
-            return Void();
-        }
-
-        active = user + nice + system;
-        total = active + idle;
-
-        // Read online CPU information.
-        snprintf(file_name, MAX_LENGTH, CPU_ONLINE_FILE_FORMAT, cpu_num);
-        cpu_file = fopen(file_name, "r");
-        online = 0;
-
-        snprintf(cpu_name, sizeof(cpu_name), "CPU%d", cpu_num);
-        if (cpu_file == nullptr) {
-            ALOGE("%s: failed to open file: %s (%s)", __func__, file_name, strerror(errno));
-            online = cpu_num == 0;
-        } else if (1 != fscanf(cpu_file, "%d", &online)) {
-            ALOGE("%s: failed to read CPU online information from file: %s (%s)", __func__,
-                    file_name, strerror(errno));
-            fclose(file);
-            fclose(cpu_file);
-            status.code = V1_0::ThermalStatusCode::FAILURE;
-            status.debugMessage = strerror(-EIO);
-            _hidl_cb(status, cpuUsages);
-            return Void();
-        } else {
-            fclose(cpu_file);
-        }
-
-        CpuUsage usage;
-        usage.name = cpu_name;
-        usage.active = active;
-        usage.total = total;
-        usage.isOnline = (online != 0) ? true : false;
-        cpuUsages.push_back(usage);
+    if (mPassive) {
+        mWatcher->readCpuOnline();
+    }
+    if (!readCpuUsages(&cpuUsages)) {
+        status.code = V1_0::ThermalStatusCode::FAILURE;
+        status.debugMessage = strerror(-EIO);
+        _hidl_cb(status, cpuUsages);
+        return Void();
     }
     cpuUsages_reply.setToExternal(cpuUsages.data(), cpuUsages.size());
     _hidl_cb(status, cpuUsages_reply);
@@ -200,9 +554,23 @@ Return<void> Thermal::getCpuUsages(getCpuUsages_cb _hidl_cb) {
 }
 
 Return<void> Thermal::getCoolingDevices(getCoolingDevices_cb _hidl_cb) {
+    CallScope scope(this, ThermalMetrics::GET_COOLING_DEVICES);
     ThermalStatus status;
     status.code = V1_0::ThermalStatusCode::SUCCESS;
+
+    // The actuators the watcher records, such as the GPU's devfreq cap, as
+    // of the last evaluation. 1.0 only knows fans, so every device is
+    // reported as one with its cooling state as the value.
+    uint8_t states[kMaxSnapshotActuators];
+    const size_t count = mSnapshot.actuatorStates(states, kMaxSnapshotActuators);
+    const std::vector<std::string> names = mSnapshot.actuatorNames();
     hidl_vec<CoolingDevice> coolingDevices;
+    coolingDevices.resize(std::min(count, names.size()));
+    for (size_t i = 0; i < coolingDevices.size(); ++i) {
+        coolingDevices[i].type = V1_0::CoolingType::FAN_RPM;
+        coolingDevices[i].name = names[i];
+        coolingDevices[i].currentValue = states[i];
+    }
     _hidl_cb(status, coolingDevices);
     return Void();
 
@@ -210,26 +578,167 @@ Return<void> Thermal::getCoolingDevices(getCoolingDevices_cb _hidl_cb) {
 
 Return<void> Thermal::registerThermalCallback(const sp<IThermalCallback>& callback)
 {
+    CallScope scope(this, ThermalMetrics::REGISTER_THERMAL_CALLBACK);
     if (callback == nullptr)  {
         ALOGE("%s: Null callback ignored", __func__);
         return Void();
     }
 
-    sThermalCb = callback;
+    {
+        std::lock_guard<std::mutex> _lock(sThermalCbLock);
+        sThermalCb = callback;
+    }
+
+    // The client learns where the zones stand as of the last evaluation:
+    // every throttling zone, or the hottest one when none is.
+    std::vector<Temperature> throttling;
+    Temperature hottest;
+    hottest.currentValue = NAN;
+    const auto table = mWatcher->zoneTable();
+    for (size_t i = 0; table != nullptr && i < table->zones.size(); ++i) {
+        const auto& zone = table->zones[i];
+        const float temperature = mSnapshot.temperature(i);
+        if (zone.tempFd == nullptr || isnan(temperature)) {
+            continue;
+        }
+        if (mSnapshot.level(i) != SeverityLevel::NONE) {
+            throttling.push_back(makeTemperature(zone.name, temperature, zone.zoneClass));
+        } else if (!(temperature <= hottest.currentValue)) {
+            hottest = makeTemperature(zone.name, temperature, zone.zoneClass);
+        }
+    }
+    bool ok = true;
+    for (const auto& temperature : throttling) {
+        ok &= callback->notifyThrottling(true, temperature).isOk();
+    }
+    if (throttling.empty() && !isnan(hottest.currentValue)) {
+        ok &= callback->notifyThrottling(false, hottest).isOk();
+    }
+    if (!ok) {
+        ALOGE("%s: failed to send the current state", __func__);
+    }
+
+    return Void();
+}
+
+void Thermal::inject(int fd, const hidl_vec<hidl_string>& args) {
+    // Fake temperatures drive real notifications, so only on debug builds.
+    if (!android::base::GetBoolProperty(DEBUGGABLE_PROPERTY, false)) {
+        dprintf(fd, "inject is only available on debuggable builds\n");
+        return;
+    }
+
+    std::vector<float> temperatures;
+    int stepMs = 0;
+    if (args.size() == 2 && std::string(args[1]) == "stop") {
+        mWatcher->injectProfile("", 0, temperatures);
+        dprintf(fd, "injection stopped\n");
+        return;
+    }
+    bool valid = args.size() == 4 && android::base::ParseInt(std::string(args[2]), &stepMs, 1);
+    const std::string profile = valid ? std::string(args[3]) : "";
+    for (const auto& value : android::base::Split(profile, ",")) {
+        char *end;
+        temperatures.push_back(strtof(value.c_str(), &end));
+        valid &= !value.empty() && *end == '\0';
+    }
+    if (!valid) {
+        dprintf(fd, "usage: inject <zone type> <step ms> <celsius>[,<celsius>...]\n"
+                    "       inject stop\n");
+        return;
+    }
+    if (!mWatcher->injectProfile(args[1], stepMs * 1000000LL, temperatures)) {
+        dprintf(fd, "no zone of type %s\n", args[1].c_str());
+        return;
+    }
+    dprintf(fd, "injecting %zu temperatures into %s, see dump for the latency breakdown\n",
+            temperatures.size(), args[1].c_str());
+}
+
+void Thermal::timeline(int fd, const hidl_vec<hidl_string>& args) {
+    if (args.size() == 2 && (std::string(args[1]) == "start" || std::string(args[1]) == "stop")) {
+        mTimeline.setEnabled(std::string(args[1]) == "start");
+        dprintf(fd, "timeline %s\n", mTimeline.enabled() ? "started" : "stopped");
+        return;
+    }
+    if (args.size() != 1) {
+        dprintf(fd, "usage: timeline [start|stop]\n"
+                    "  without arguments, writes the recorded events as Chrome trace JSON\n");
+        return;
+    }
+
+    std::vector<std::string> zoneNames;
+    const auto table = mWatcher->zoneTable();
+    if (table != nullptr) {
+        for (const auto& zone : table->zones) {
+            zoneNames.push_back(zone.name);
+        }
+    }
+    mTimeline.writeJson(fd, zoneNames, mSnapshot.actuatorNames());
+}
 
-    Temperature temperature;
-    temperature.type = V1_0::TemperatureType::CPU;
-    temperature.name = "thermal";
-    temperature.currentValue = finalizeTemperature(UNKNOWN_TEMPERATURE);
-    temperature.throttlingThreshold = finalizeTemperature(THROTTLING_THRESHOLD);
-    temperature.shutdownThreshold = finalizeTemperature(SHUTDOWN_THRESHOLD);
-    temperature.vrThrottlingThreshold = finalizeTemperature(UNKNOWN_TEMPERATURE);
+Return<void> Thermal::debug(const hidl_handle& handle, const hidl_vec<hidl_string>& args) {
+    if (handle == nullptr || handle->numFds < 1) {
+        ALOGE("%s: no fd to dump to", __func__);
+        return Void();
+    }
 
-    sThermalCb->notifyThrottling(false, temperature);
+    int fd = handle->data[0];
+    if (args.size() > 0 && std::string(args[0]) == "inject") {
+        inject(fd, args);
+        fsync(fd);
+        return Void();
+    }
+    if (args.size() > 0 && std::string(args[0]) == "timeline") {
+        timeline(fd, args);
+        fsync(fd);
+        return Void();
+    }
 
+    dprintf(fd, "Startup:\n");
+    dprintf(fd, "  process start: %" PRId64 " ms after boot\n", mProcessStartNs / 1000000);
+    const std::pair<const char*, int64_t> milestones[] = {
+        {"discovery done", mDiscoveredNs},
+        {"registered", mRegisteredNs},
+        {"first call", mFirstCallNs},
+    };
+    for (const auto& milestone : milestones) {
+        if (milestone.second == 0 || mProcessStartNs == 0) {
+            dprintf(fd, "  %s: -\n", milestone.first);
+        } else {
+            dprintf(fd, "  %s: +%" PRId64 " ms\n", milestone.first,
+                    (milestone.second - mProcessStartNs) / 1000000);
+        }
+    }
+    std::string status;
+    if (android::base::ReadFileToString("/proc/self/status", &status)) {
+        for (const auto& line : android::base::Split(status, "\n")) {
+            if (android::base::StartsWith(line, "VmRSS:") ||
+                android::base::StartsWith(line, "VmHWM:")) {
+                dprintf(fd, "  %s\n", line.c_str());
+            }
+        }
+    }
+    mWatcher->dump(fd);
+    if (mTuning != nullptr) {
+        mTuning->dump(fd);
+    }
+    mSnapshot.dump(fd);
+    mJournal.dump(fd);
+    fsync(fd);
     return Void();
 }
 
+IThermal* HIDL_FETCH_IThermal(const char* name) {
+    // No real instance name starts with a slash; the transport benchmark
+    // passes the root of its fake tree this way, since the library it gets
+    // has its own copy of the watcher's root.
+    if (name != nullptr && name[0] == '/') {
+        ThermalWatcher::setRootDir(name);
+    }
+    return new Thermal(true);
+}
+
 }  // namespace renesas
 }  // namespace V1_1
 }  // namespace thermal
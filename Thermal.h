@@ -22,6 +22,20 @@
 
 #include <hidl/MQDescriptor.h>
 
+#include <atomic>
+#include <functional>
+#include <mutex>
+
+#include "BoardProfile.h"
+#include "ThermalConfig.h"
+#include "ThermalJournal.h"
+#include "ThermalMetrics.h"
+#include "ThermalSnapshot.h"
+#include "ThermalTimeline.h"
+#include "ThermalTrace.h"
+#include "ThermalTuning.h"
+#include "ThermalWatcher.h"
+
 namespace android {
 namespace hardware {
 namespace thermal {
@@ -37,10 +51,15 @@ using ::android::hardware::Return;
 using ::android::hardware::Void;
 using ::android::hardware::hidl_vec;
 using ::android::hardware::hidl_string;
+using ::android::hardware::hidl_handle;
 using ::android::sp;
 
 struct Thermal : public IThermal {
-    Thermal();
+    // A passive instance, as loaded in process by HIDL_FETCH_IThermal(),
+    // reads sysfs on each call and does nothing in between: it starts no
+    // watcher thread, moves no trip points, writes no shared files and
+    // serves neither tuning nor metrics. Its callbacks are never called.
+    explicit Thermal(bool passive = false);
     // Methods from ::android::hardware::thermal::V1_0::IThermal follow.
     Return<void> getTemperatures(getTemperatures_cb _hidl_cb)  override;
     Return<void> getCpuUsages(getCpuUsages_cb _hidl_cb)  override;
@@ -49,9 +68,109 @@ struct Thermal : public IThermal {
     // Methods from ::android::hardware::thermal::V1_1::IThermal follow.
     Return<void> registerThermalCallback(const sp<IThermalCallback>& callback) override;
 
+    // Methods from ::android::hidl::base::V1_0::IBase follow.
+    Return<void> debug(const hidl_handle& fd, const hidl_vec<hidl_string>& args) override;
+
     static sp<IThermalCallback> sThermalCb;
+    static std::mutex sThermalCbLock;
+
+    // Helpers shared with the extension interfaces and the other front-ends.
+    Temperature makeTemperature(const std::string& name, float temperature,
+                                ZoneClass zoneClass) const;
+    struct ZoneReading {
+        size_t zone;
+        float temperature;
+    };
+    // Reads the listed zones of table, or takes their last sampled values
+    // from the snapshot when cached is set. Zones without a value are left
+    // out.
+    void readZones(const ThermalWatcher::ZoneTable& table, const std::vector<size_t>& zones,
+                   bool cached, std::vector<ZoneReading>* readings);
+    const sp<ThermalWatcher>& watcher() const { return mWatcher; }
+    const ThermalConfig& config() const { return mConfig; }
+    // Null until the zones are known.
+    const sp<ThermalTuning>& tuning() const { return mTuning; }
+    ThermalSnapshot& snapshot() { return mSnapshot; }
+
+    // Called on the watcher thread for a severity level transition. Returns
+    // false once its client is gone, which removes it.
+    using ThrottlingNotifier = std::function<bool(const std::string& name, ZoneClass zoneClass,
+                                                  float temperature, SeverityLevel level)>;
+    // Adds a notifier for transitions of zones of class *zoneClass, or of
+    // every zone when zoneClass is null, and returns its id. Transitions of
+    // other zones never reach it.
+    uint32_t addThrottlingNotifier(const ZoneClass *zoneClass, const ThrottlingNotifier& notifier);
+    void removeThrottlingNotifier(uint32_t id);
+
+    // Called by main() once every interface is registered.
+    void markRegistered();
+
+    // Lives for the duration of a HAL method of any front-end: marks the
+    // first call and feeds the call latency histogram and the timeline.
+    class CallScope {
+      public:
+        CallScope(Thermal* thermal, ThermalMetrics::Call call);
+        ~CallScope();
+
+      private:
+        Thermal* mThermal;
+        ThermalMetrics::Call mCall;
+        int64_t mStartNs;
+    };
+
+  private:
+    struct Notifier {
+        uint32_t id;
+        bool filterClass;
+        ZoneClass zoneClass;
+        ThrottlingNotifier notify;
+    };
+
+    void notifyThrottling(const std::string& name, float temperature, SeverityLevel level);
+    void markCall(int64_t nowNs);
+    // Parses the per-CPU lines of /proc/stat. Returns false on a malformed
+    // line.
+    bool readCpuUsages(std::vector<CpuUsage>* cpuUsages);
+    // Finds the zones for a passive instance, see the constructor.
+    void startPassive();
+    // Applies a compiled-in board profile in place of zone discovery and the
+    // configuration file. Returns false if the board does not match it.
+    template <size_t Zones, size_t Clusters, size_t Actuators>
+    bool useBoardProfile(const BoardProfile<Zones, Clusters, Actuators>& profile,
+                         ThermalWatcher::SchedulingPolicy policy);
+    // Handles "lshal debug ... inject"; see ThermalWatcher::injectProfile().
+    void inject(int fd, const hidl_vec<hidl_string>& args);
+    // Handles "lshal debug ... timeline [start|stop]"; see ThermalTimeline.
+    void timeline(int fd, const hidl_vec<hidl_string>& args);
+
+    const bool mPassive;
+    ThermalConfig mConfig;
+    ThermalSnapshot mSnapshot;
+    ThermalJournal mJournal;
+    ThermalTraceWriter mTrace;
+    ThermalTimeline mTimeline;
+    sp<ThermalWatcher> mWatcher;
+    sp<ThermalMetrics> mMetrics;
+    sp<ThermalTuning> mTuning;
+    std::mutex mNotifierLock;
+    std::vector<Notifier> mNotifiers;
+    uint32_t mNextNotifierId = 1;
+    // Kept open so that getCpuUsages() does not open /proc/stat every call.
+    ::android::base::unique_fd mStatFd;
+    // CPU lines in /proc/stat as of the last read.
+    std::atomic<size_t> mCpuLines{0};
+
+    // Startup milestones in boot clock nanoseconds, 0 until reached.
+    const int64_t mProcessStartNs;
+    int64_t mDiscoveredNs = 0;
+    std::atomic<int64_t> mRegisteredNs{0};
+    std::atomic<int64_t> mFirstCallNs{0};
 };
 
+// name is the instance asked for; one that is an absolute path is taken as
+// the root of a fake sysfs tree, see ThermalWatcher::setRootDir().
+extern "C" IThermal* HIDL_FETCH_IThermal(const char* name);
+
 }  // namespace renesas
 }  // namespace V1_0
 }  // namespace thermal
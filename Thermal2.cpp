@@ -0,0 +1,271 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "ThermalHAL"
+
+#include <errno.h>
+#include <math.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include <hidl/HidlSupport.h>
+#include <log/log.h>
+
+#include "Thermal2.h"
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+using ::android::hardware::interfacesEqual;
+
+// ZoneClass numbers the known types like HAL 2.0 does.
+static bool toZoneClass(V2_0::TemperatureType type, ZoneClass *zoneClass) {
+    const int32_t value = static_cast<int32_t>(type);
+    if (type == V2_0::TemperatureType::UNKNOWN) {
+        *zoneClass = ZoneClass::UNKNOWN;
+    } else if (value >= 0 && value < static_cast<int32_t>(ZoneClass::UNKNOWN)) {
+        *zoneClass = static_cast<ZoneClass>(value);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static V2_0::TemperatureType toTemperatureType(ZoneClass zoneClass) {
+    return zoneClass == ZoneClass::UNKNOWN ? V2_0::TemperatureType::UNKNOWN
+                                           : static_cast<V2_0::TemperatureType>(zoneClass);
+}
+
+// SeverityLevel stops at EMERGENCY; SHUTDOWN is left to the kernel's
+// critical trip point.
+static V2_0::ThrottlingSeverity toSeverity(SeverityLevel level) {
+    return static_cast<V2_0::ThrottlingSeverity>(level);
+}
+
+static V2_0::Temperature makeTemperature(const std::string& name, ZoneClass zoneClass,
+                                         float temperature, SeverityLevel level) {
+    V2_0::Temperature t;
+    t.type = toTemperatureType(zoneClass);
+    t.name = name;
+    t.value = temperature;
+    t.throttlingStatus = toSeverity(level);
+    return t;
+}
+
+static ThermalStatus failure(int error) {
+    ThermalStatus status;
+    status.code = V1_0::ThermalStatusCode::FAILURE;
+    status.debugMessage = strerror(error);
+    return status;
+}
+
+Thermal2::Thermal2(const sp<Thermal>& thermal) : mThermal(thermal) {}
+
+// Methods from ::android::hardware::thermal::V1_0::IThermal follow.
+Return<void> Thermal2::getTemperatures(getTemperatures_cb _hidl_cb) {
+    return mThermal->getTemperatures(_hidl_cb);
+}
+
+Return<void> Thermal2::getCpuUsages(getCpuUsages_cb _hidl_cb) {
+    return mThermal->getCpuUsages(_hidl_cb);
+}
+
+Return<void> Thermal2::getCoolingDevices(getCoolingDevices_cb _hidl_cb) {
+    return mThermal->getCoolingDevices(_hidl_cb);
+}
+
+// Methods from ::android::hardware::thermal::V2_0::IThermal follow.
+Return<void> Thermal2::getCurrentTemperatures(bool filterType, V2_0::TemperatureType type,
+                                              getCurrentTemperatures_cb _hidl_cb) {
+    Thermal::CallScope scope(mThermal.get(), ThermalMetrics::GET_CURRENT_TEMPERATURES);
+    ThermalStatus status;
+    status.code = V1_0::ThermalStatusCode::SUCCESS;
+    hidl_vec<V2_0::Temperature> temperatures;
+
+    const auto table = mThermal->watcher()->zoneTable();
+    ZoneClass zoneClass;
+    if (table == nullptr) {
+        _hidl_cb(failure(ENOENT), temperatures);
+        return Void();
+    }
+    if (filterType && !toZoneClass(type, &zoneClass)) {
+        _hidl_cb(failure(EINVAL), temperatures);
+        return Void();
+    }
+
+    std::vector<Thermal::ZoneReading> readings;
+    mThermal->readZones(*table,
+                        filterType ? table->byClass[static_cast<size_t>(zoneClass)] : table->live,
+                        false, &readings);
+    temperatures.resize(readings.size());
+    for (size_t i = 0; i < readings.size(); ++i) {
+        const auto& zone = table->zones[readings[i].zone];
+        temperatures[i] = makeTemperature(zone.name, zone.zoneClass, readings[i].temperature,
+                                          mThermal->snapshot().level(readings[i].zone));
+    }
+
+    if (temperatures.size() == 0 && !filterType) {
+        status = failure(ENOENT);
+    }
+    _hidl_cb(status, temperatures);
+    return Void();
+}
+
+Return<void> Thermal2::getTemperatureThresholds(bool filterType, V2_0::TemperatureType type,
+                                                getTemperatureThresholds_cb _hidl_cb) {
+    Thermal::CallScope scope(mThermal.get(), ThermalMetrics::GET_TEMPERATURE_THRESHOLDS);
+    ThermalStatus status;
+    status.code = V1_0::ThermalStatusCode::SUCCESS;
+    hidl_vec<V2_0::TemperatureThreshold> thresholds;
+
+    const auto table = mThermal->watcher()->zoneTable();
+    ZoneClass zoneClass;
+    if (table == nullptr) {
+        _hidl_cb(failure(ENOENT), thresholds);
+        return Void();
+    }
+    if (filterType && !toZoneClass(type, &zoneClass)) {
+        _hidl_cb(failure(EINVAL), thresholds);
+        return Void();
+    }
+
+    const auto& zones = filterType ? table->byClass[static_cast<size_t>(zoneClass)]
+                                   : table->live;
+    thresholds.resize(zones.size());
+    for (size_t i = 0; i < zones.size(); ++i) {
+        const auto& zone = table->zones[zones[i]];
+        const ZoneConfig& config = mThermal->config().zone(zone.name);
+        V2_0::TemperatureThreshold& threshold = thresholds[i];
+        threshold.type = toTemperatureType(zone.zoneClass);
+        threshold.name = zone.name;
+        for (size_t l = 0; l < threshold.hotThrottlingThresholds.size(); ++l) {
+            threshold.hotThrottlingThresholds[l] = l < kNumSeverityLevels ? config.hot[l] : NAN;
+            threshold.coldThrottlingThresholds[l] = l < kNumSeverityLevels ? config.cold[l] : NAN;
+        }
+        threshold.vrThrottlingThreshold = NAN;
+    }
+    _hidl_cb(status, thresholds);
+    return Void();
+}
+
+Return<void> Thermal2::registerThermalChangedCallback(
+        const sp<V2_0::IThermalChangedCallback>& callback, bool filterType,
+        V2_0::TemperatureType type, registerThermalChangedCallback_cb _hidl_cb) {
+    Thermal::CallScope scope(mThermal.get(), ThermalMetrics::REGISTER_THERMAL_CHANGED_CALLBACK);
+    ThermalStatus status;
+    status.code = V1_0::ThermalStatusCode::SUCCESS;
+
+    ZoneClass zoneClass;
+    if (callback == nullptr || (filterType && !toZoneClass(type, &zoneClass))) {
+        ALOGE("%s: invalid callback or type", __func__);
+        _hidl_cb(failure(EINVAL));
+        return Void();
+    }
+
+    std::lock_guard<std::mutex> _lock(mLock);
+    if (std::any_of(mClients.begin(), mClients.end(), [&callback](const Client& c) {
+            return interfacesEqual(c.callback, callback);
+        })) {
+        _hidl_cb(failure(EEXIST));
+        return Void();
+    }
+    // The watcher thread only calls back for the zones asked for.
+    const uint32_t notifier = mThermal->addThrottlingNotifier(
+            filterType ? &zoneClass : nullptr,
+            [this, callback](const std::string& name, ZoneClass changedClass, float temperature,
+                             SeverityLevel level) {
+                auto ret = callback->notifyThrottling(
+                        makeTemperature(name, changedClass, temperature, level));
+                if (ret.isOk() || !ret.isDeadObject()) {
+                    return true;
+                }
+                std::lock_guard<std::mutex> _lock(mLock);
+                mClients.erase(std::remove_if(mClients.begin(), mClients.end(),
+                                              [&callback](const Client& c) {
+                                                  return c.callback == callback;
+                                              }),
+                               mClients.end());
+                ALOGI("%s: dropped dead callback", __func__);
+                return false;
+            });
+    mClients.push_back({callback, notifier});
+    _hidl_cb(status);
+    return Void();
+}
+
+Return<void> Thermal2::unregisterThermalChangedCallback(
+        const sp<V2_0::IThermalChangedCallback>& callback,
+        unregisterThermalChangedCallback_cb _hidl_cb) {
+    Thermal::CallScope scope(mThermal.get(), ThermalMetrics::UNREGISTER_THERMAL_CHANGED_CALLBACK);
+    ThermalStatus status;
+    status.code = V1_0::ThermalStatusCode::SUCCESS;
+
+    std::lock_guard<std::mutex> _lock(mLock);
+    auto it = std::find_if(mClients.begin(), mClients.end(), [&callback](const Client& c) {
+        return interfacesEqual(c.callback, callback);
+    });
+    if (callback == nullptr || it == mClients.end()) {
+        _hidl_cb(failure(ENOENT));
+        return Void();
+    }
+    mThermal->removeThrottlingNotifier(it->notifier);
+    mClients.erase(it);
+    _hidl_cb(status);
+    return Void();
+}
+
+Return<void> Thermal2::getCurrentCoolingDevices(bool filterType, V2_0::CoolingType type,
+                                                getCurrentCoolingDevices_cb _hidl_cb) {
+    Thermal::CallScope scope(mThermal.get(), ThermalMetrics::GET_CURRENT_COOLING_DEVICES);
+    ThermalStatus status;
+    status.code = V1_0::ThermalStatusCode::SUCCESS;
+
+    // The watcher records every actuator's state after each evaluation.
+    uint8_t states[kMaxSnapshotActuators];
+    const size_t count = mThermal->snapshot().actuatorStates(states, kMaxSnapshotActuators);
+    const std::vector<std::string> names = mThermal->snapshot().actuatorNames();
+    std::vector<V2_0::CoolingDevice> devices;
+    for (size_t i = 0; i < count && i < names.size(); ++i) {
+        const auto coolingType = static_cast<V2_0::CoolingType>(classifyCoolingDevice(names[i]));
+        if (filterType && coolingType != type) {
+            continue;
+        }
+        V2_0::CoolingDevice device;
+        device.type = coolingType;
+        device.name = names[i];
+        device.value = states[i];
+        devices.push_back(device);
+    }
+
+    hidl_vec<V2_0::CoolingDevice> reply;
+    reply.setToExternal(devices.data(), devices.size());
+    _hidl_cb(status, reply);
+    return Void();
+}
+
+Return<void> Thermal2::debug(const hidl_handle& fd, const hidl_vec<hidl_string>& args) {
+    return mThermal->debug(fd, args);
+}
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
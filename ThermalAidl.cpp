@@ -0,0 +1,291 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "ThermalHAL"
+
+#include <math.h>
+
+#include <algorithm>
+
+#include <android/binder_enums.h>
+#include <log/log.h>
+
+#include "ThermalAidl.h"
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+using ::ndk::ScopedAStatus;
+
+// Whether the interface defines type, which need not be one that any zone
+// here can have.
+static bool isTemperatureType(aidl_thermal::TemperatureType type) {
+    const auto types = ::ndk::enum_range<aidl_thermal::TemperatureType>();
+    return std::find(types.begin(), types.end(), type) != types.end();
+}
+
+// ZoneClass numbers the known types like the AIDL TemperatureType does.
+// Returns false for the types it has no class for, such as TPU or SOC.
+static bool toZoneClass(aidl_thermal::TemperatureType type, ZoneClass *zoneClass) {
+    const int32_t value = static_cast<int32_t>(type);
+    if (type == aidl_thermal::TemperatureType::UNKNOWN) {
+        *zoneClass = ZoneClass::UNKNOWN;
+    } else if (value >= 0 && value < static_cast<int32_t>(ZoneClass::UNKNOWN)) {
+        *zoneClass = static_cast<ZoneClass>(value);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static aidl_thermal::TemperatureType toTemperatureType(ZoneClass zoneClass) {
+    return zoneClass == ZoneClass::UNKNOWN ? aidl_thermal::TemperatureType::UNKNOWN
+                                           : static_cast<aidl_thermal::TemperatureType>(zoneClass);
+}
+
+static aidl_thermal::Temperature makeTemperature(const std::string& name, ZoneClass zoneClass,
+                                                 float temperature, SeverityLevel level) {
+    aidl_thermal::Temperature t;
+    t.type = toTemperatureType(zoneClass);
+    t.name = name;
+    t.value = temperature;
+    t.throttlingStatus = static_cast<aidl_thermal::ThrottlingSeverity>(level);
+    return t;
+}
+
+static ScopedAStatus invalidType() {
+    return ScopedAStatus::fromExceptionCodeWithMessage(EX_ILLEGAL_ARGUMENT, "invalid type");
+}
+
+static bool sameCallback(const std::shared_ptr<aidl_thermal::IThermalChangedCallback>& a,
+                         const std::shared_ptr<aidl_thermal::IThermalChangedCallback>& b) {
+    return a->asBinder() == b->asBinder();
+}
+
+ThermalAidl::ThermalAidl(const sp<Thermal>& thermal) : mThermal(thermal) {}
+
+ScopedAStatus ThermalAidl::getTemperatures(std::vector<aidl_thermal::Temperature>* _aidl_return) {
+    return temperatures(nullptr, _aidl_return);
+}
+
+ScopedAStatus ThermalAidl::getTemperaturesWithType(
+        aidl_thermal::TemperatureType type,
+        std::vector<aidl_thermal::Temperature>* _aidl_return) {
+    if (!isTemperatureType(type)) {
+        return invalidType();
+    }
+    ZoneClass zoneClass;
+    if (!toZoneClass(type, &zoneClass)) {
+        Thermal::CallScope scope(mThermal.get(), ThermalMetrics::AIDL_GET_TEMPERATURES);
+        _aidl_return->clear();
+        return ScopedAStatus::ok();
+    }
+    return temperatures(&zoneClass, _aidl_return);
+}
+
+ScopedAStatus ThermalAidl::temperatures(const ZoneClass *zoneClass,
+                                        std::vector<aidl_thermal::Temperature>* temperatures) {
+    Thermal::CallScope scope(mThermal.get(), ThermalMetrics::AIDL_GET_TEMPERATURES);
+    const auto table = mThermal->watcher()->zoneTable();
+    if (table == nullptr) {
+        return ScopedAStatus::fromExceptionCodeWithMessage(EX_ILLEGAL_STATE, "no thermal zones");
+    }
+
+    std::vector<Thermal::ZoneReading> readings;
+    mThermal->readZones(*table,
+                        zoneClass != nullptr ? table->byClass[static_cast<size_t>(*zoneClass)]
+                                             : table->live,
+                        false, &readings);
+    temperatures->clear();
+    temperatures->reserve(readings.size());
+    for (const auto& reading : readings) {
+        const auto& zone = table->zones[reading.zone];
+        temperatures->push_back(makeTemperature(zone.name, zone.zoneClass, reading.temperature,
+                                                mThermal->snapshot().level(reading.zone)));
+    }
+    return ScopedAStatus::ok();
+}
+
+ScopedAStatus ThermalAidl::getTemperatureThresholds(
+        std::vector<aidl_thermal::TemperatureThreshold>* _aidl_return) {
+    return thresholds(nullptr, _aidl_return);
+}
+
+ScopedAStatus ThermalAidl::getTemperatureThresholdsWithType(
+        aidl_thermal::TemperatureType type,
+        std::vector<aidl_thermal::TemperatureThreshold>* _aidl_return) {
+    if (!isTemperatureType(type)) {
+        return invalidType();
+    }
+    ZoneClass zoneClass;
+    if (!toZoneClass(type, &zoneClass)) {
+        Thermal::CallScope scope(mThermal.get(), ThermalMetrics::AIDL_GET_TEMPERATURE_THRESHOLDS);
+        _aidl_return->clear();
+        return ScopedAStatus::ok();
+    }
+    return thresholds(&zoneClass, _aidl_return);
+}
+
+ScopedAStatus ThermalAidl::thresholds(
+        const ZoneClass *zoneClass, std::vector<aidl_thermal::TemperatureThreshold>* thresholds) {
+    Thermal::CallScope scope(mThermal.get(), ThermalMetrics::AIDL_GET_TEMPERATURE_THRESHOLDS);
+    const auto table = mThermal->watcher()->zoneTable();
+    if (table == nullptr) {
+        return ScopedAStatus::fromExceptionCodeWithMessage(EX_ILLEGAL_STATE, "no thermal zones");
+    }
+
+    const auto& zones = zoneClass != nullptr ? table->byClass[static_cast<size_t>(*zoneClass)]
+                                             : table->live;
+    thresholds->clear();
+    thresholds->reserve(zones.size());
+    for (size_t index : zones) {
+        const auto& zone = table->zones[index];
+        const ZoneConfig& config = mThermal->config().zone(zone.name);
+        aidl_thermal::TemperatureThreshold threshold;
+        threshold.type = toTemperatureType(zone.zoneClass);
+        threshold.name = zone.name;
+        // One entry per ThrottlingSeverity; SHUTDOWN is left to the kernel.
+        threshold.hotThrottlingThresholds.assign(config.hot.begin(), config.hot.end());
+        threshold.hotThrottlingThresholds.push_back(NAN);
+        threshold.coldThrottlingThresholds.assign(config.cold.begin(), config.cold.end());
+        threshold.coldThrottlingThresholds.push_back(NAN);
+        thresholds->push_back(std::move(threshold));
+    }
+    return ScopedAStatus::ok();
+}
+
+ScopedAStatus ThermalAidl::getCoolingDevices(
+        std::vector<aidl_thermal::CoolingDevice>* _aidl_return) {
+    return coolingDevices(nullptr, _aidl_return);
+}
+
+ScopedAStatus ThermalAidl::getCoolingDevicesWithType(
+        aidl_thermal::CoolingType type, std::vector<aidl_thermal::CoolingDevice>* _aidl_return) {
+    return coolingDevices(&type, _aidl_return);
+}
+
+ScopedAStatus ThermalAidl::coolingDevices(const aidl_thermal::CoolingType *type,
+                                          std::vector<aidl_thermal::CoolingDevice>* devices) {
+    Thermal::CallScope scope(mThermal.get(), ThermalMetrics::AIDL_GET_COOLING_DEVICES);
+    uint8_t states[kMaxSnapshotActuators];
+    const size_t count = mThermal->snapshot().actuatorStates(states, kMaxSnapshotActuators);
+    const std::vector<std::string> names = mThermal->snapshot().actuatorNames();
+    devices->clear();
+    for (size_t i = 0; i < count && i < names.size(); ++i) {
+        const auto coolingType =
+                static_cast<aidl_thermal::CoolingType>(classifyCoolingDevice(names[i]));
+        if (type != nullptr && coolingType != *type) {
+            continue;
+        }
+        aidl_thermal::CoolingDevice device;
+        device.type = coolingType;
+        device.name = names[i];
+        device.value = states[i];
+        devices->push_back(device);
+    }
+    return ScopedAStatus::ok();
+}
+
+ScopedAStatus ThermalAidl::registerThermalChangedCallback(
+        const std::shared_ptr<aidl_thermal::IThermalChangedCallback>& callback) {
+    return registerCallback(callback, nullptr, false);
+}
+
+ScopedAStatus ThermalAidl::registerThermalChangedCallbackWithType(
+        const std::shared_ptr<aidl_thermal::IThermalChangedCallback>& callback,
+        aidl_thermal::TemperatureType type) {
+    if (!isTemperatureType(type)) {
+        return invalidType();
+    }
+    // No zone has a type without a class, so such a callback is kept but
+    // never called.
+    ZoneClass zoneClass;
+    const bool hasClass = toZoneClass(type, &zoneClass);
+    return registerCallback(callback, hasClass ? &zoneClass : nullptr, !hasClass);
+}
+
+ScopedAStatus ThermalAidl::registerCallback(
+        const std::shared_ptr<aidl_thermal::IThermalChangedCallback>& callback,
+        const ZoneClass *zoneClass, bool noZones) {
+    Thermal::CallScope scope(mThermal.get(), ThermalMetrics::AIDL_REGISTER_CALLBACK);
+    if (callback == nullptr) {
+        return ScopedAStatus::fromExceptionCodeWithMessage(EX_NULL_POINTER, "null callback");
+    }
+
+    std::lock_guard<std::mutex> _lock(mLock);
+    if (std::any_of(mClients.begin(), mClients.end(), [&callback](const Client& c) {
+            return sameCallback(c.callback, callback);
+        })) {
+        return ScopedAStatus::fromExceptionCodeWithMessage(EX_ILLEGAL_ARGUMENT,
+                                                           "callback already registered");
+    }
+    if (noZones) {
+        mClients.push_back({callback, 0});
+        return ScopedAStatus::ok();
+    }
+    // The watcher thread only calls back for the zones asked for.
+    const uint32_t notifier = mThermal->addThrottlingNotifier(
+            zoneClass,
+            [this, callback](const std::string& name, ZoneClass changedClass, float temperature,
+                             SeverityLevel level) {
+                const ScopedAStatus ret = callback->notifyThrottling(
+                        makeTemperature(name, changedClass, temperature, level));
+                if (ret.isOk() || ret.getStatus() != STATUS_DEAD_OBJECT) {
+                    return true;
+                }
+                std::lock_guard<std::mutex> _lock(mLock);
+                mClients.erase(std::remove_if(mClients.begin(), mClients.end(),
+                                              [&callback](const Client& c) {
+                                                  return c.callback == callback;
+                                              }),
+                               mClients.end());
+                ALOGI("%s: dropped dead callback", __func__);
+                return false;
+            });
+    mClients.push_back({callback, notifier});
+    return ScopedAStatus::ok();
+}
+
+ScopedAStatus ThermalAidl::unregisterThermalChangedCallback(
+        const std::shared_ptr<aidl_thermal::IThermalChangedCallback>& callback) {
+    Thermal::CallScope scope(mThermal.get(), ThermalMetrics::AIDL_UNREGISTER_CALLBACK);
+    if (callback == nullptr) {
+        return ScopedAStatus::fromExceptionCodeWithMessage(EX_NULL_POINTER, "null callback");
+    }
+
+    std::lock_guard<std::mutex> _lock(mLock);
+    auto it = std::find_if(mClients.begin(), mClients.end(), [&callback](const Client& c) {
+        return sameCallback(c.callback, callback);
+    });
+    if (it == mClients.end()) {
+        return ScopedAStatus::fromExceptionCodeWithMessage(EX_ILLEGAL_ARGUMENT,
+                                                           "callback not registered");
+    }
+    if (it->notifier != 0) {
+        mThermal->removeThrottlingNotifier(it->notifier);
+    }
+    mClients.erase(it);
+    return ScopedAStatus::ok();
+}
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ANDROID_HARDWARE_THERMAL_V1_1_THERMALAIDL_H
+#define ANDROID_HARDWARE_THERMAL_V1_1_THERMALAIDL_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <aidl/android/hardware/thermal/BnThermal.h>
+
+#include "Thermal.h"
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+namespace aidl_thermal = ::aidl::android::hardware::thermal;
+
+// The AIDL android.hardware.thermal.IThermal, served from the same process
+// and engine as the HIDL interfaces, like Thermal2.
+class ThermalAidl : public aidl_thermal::BnThermal {
+  public:
+    explicit ThermalAidl(const sp<Thermal>& thermal);
+
+    ::ndk::ScopedAStatus getCoolingDevices(
+            std::vector<aidl_thermal::CoolingDevice>* _aidl_return) override;
+    ::ndk::ScopedAStatus getCoolingDevicesWithType(
+            aidl_thermal::CoolingType type,
+            std::vector<aidl_thermal::CoolingDevice>* _aidl_return) override;
+    ::ndk::ScopedAStatus getTemperatures(
+            std::vector<aidl_thermal::Temperature>* _aidl_return) override;
+    ::ndk::ScopedAStatus getTemperaturesWithType(
+            aidl_thermal::TemperatureType type,
+            std::vector<aidl_thermal::Temperature>* _aidl_return) override;
+    ::ndk::ScopedAStatus getTemperatureThresholds(
+            std::vector<aidl_thermal::TemperatureThreshold>* _aidl_return) override;
+    ::ndk::ScopedAStatus getTemperatureThresholdsWithType(
+            aidl_thermal::TemperatureType type,
+            std::vector<aidl_thermal::TemperatureThreshold>* _aidl_return) override;
+    ::ndk::ScopedAStatus registerThermalChangedCallback(
+            const std::shared_ptr<aidl_thermal::IThermalChangedCallback>& callback) override;
+    ::ndk::ScopedAStatus registerThermalChangedCallbackWithType(
+            const std::shared_ptr<aidl_thermal::IThermalChangedCallback>& callback,
+            aidl_thermal::TemperatureType type) override;
+    ::ndk::ScopedAStatus unregisterThermalChangedCallback(
+            const std::shared_ptr<aidl_thermal::IThermalChangedCallback>& callback) override;
+
+  private:
+    struct Client {
+        std::shared_ptr<aidl_thermal::IThermalChangedCallback> callback;
+        // 0 if the callback was registered for a type no zone can have.
+        uint32_t notifier;
+    };
+
+    // zoneClass is null for every zone.
+    ::ndk::ScopedAStatus temperatures(const ZoneClass *zoneClass,
+                                      std::vector<aidl_thermal::Temperature>* temperatures);
+    ::ndk::ScopedAStatus thresholds(const ZoneClass *zoneClass,
+                                    std::vector<aidl_thermal::TemperatureThreshold>* thresholds);
+    ::ndk::ScopedAStatus coolingDevices(const aidl_thermal::CoolingType *type,
+                                        std::vector<aidl_thermal::CoolingDevice>* devices);
+    ::ndk::ScopedAStatus registerCallback(
+            const std::shared_ptr<aidl_thermal::IThermalChangedCallback>& callback,
+            const ZoneClass *zoneClass, bool noZones);
+
+    const sp<Thermal> mThermal;
+    std::mutex mLock;
+    std::vector<Client> mClients;
+};
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
+
+#endif  // ANDROID_HARDWARE_THERMAL_V1_1_THERMALAIDL_H
@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "ThermalHAL"
+
+#include <math.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <sstream>
+
+#include <android-base/file.h>
+#include <android-base/strings.h>
+#include <log/log.h>
+
+#include "ThermalConfig.h"
+
+#define DEFAULT_ZONE            "*"
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+const char *const kTuningAttributes[kNumTuningAttributes] = {
+    "policy", "sustainable_power", "k_po", "k_pu", "k_i", "k_d", "integral_cutoff",
+    "passive_delay", "polling_delay",
+};
+
+static bool parseTemperature(const std::string& token, float *value) {
+    if (token == "-") {
+        *value = NAN;
+        return true;
+    }
+    char *end;
+    *value = strtof(token.c_str(), &end);
+    return end != token.c_str() && *end == '\0';
+}
+
+ThermalConfig::ThermalConfig(const ZoneConfig& defaults) {
+    mZones[DEFAULT_ZONE] = defaults;
+}
+
+bool ThermalConfig::load(const std::string& path) {
+    std::string content;
+    if (!::android::base::ReadFileToString(path, &content)) {
+        return false;
+    }
+
+    int lineno = 0;
+    for (const auto& line : ::android::base::Split(content, "\n")) {
+        ++lineno;
+        std::istringstream in(line.substr(0, line.find('#')));
+        std::string key, zone;
+        if (!(in >> key)) {
+            continue;
+        }
+        if (!(in >> zone)) {
+            ALOGE("%s: %s:%d: missing zone", __func__, path.c_str(), lineno);
+            continue;
+        }
+
+        if (key == "hot" || key == "cold") {
+            SeverityThresholds values;
+            values[0] = NAN;
+            std::string token;
+            size_t l = 1;
+            for (; l < kNumSeverityLevels && in >> token; ++l) {
+                if (!parseTemperature(token, &values[l])) {
+                    break;
+                }
+            }
+            if (l != kNumSeverityLevels) {
+                ALOGE("%s: %s:%d: expected %zu temperatures", __func__, path.c_str(), lineno,
+                      kNumSeverityLevels - 1);
+                continue;
+            }
+            if (!mZones.count(zone)) {
+                mZones[zone] = mZones[DEFAULT_ZONE];
+            }
+            (key == "hot" ? mZones[zone].hot : mZones[zone].cold) = values;
+        } else if (key == "period") {
+            uint32_t periodMs;
+            if (!(in >> periodMs) || periodMs == 0) {
+                ALOGE("%s: %s:%d: expected a period in ms", __func__, path.c_str(), lineno);
+                continue;
+            }
+            if (!mZones.count(zone)) {
+                mZones[zone] = mZones[DEFAULT_ZONE];
+            }
+            mZones[zone].periodMs = periodMs;
+        } else if (key == "charge") {
+            std::vector<ChargeStep> steps;
+            ChargeStep step;
+            while (in >> step.margin >> step.percent) {
+                steps.push_back(step);
+            }
+            if (steps.empty() || !in.eof() ||
+                std::any_of(steps.begin(), steps.end(), [](const ChargeStep& s) {
+                    return s.margin < 0 || s.percent > 100;
+                })) {
+                ALOGE("%s: %s:%d: expected margin and percent pairs", __func__, path.c_str(),
+                      lineno);
+                continue;
+            }
+            std::sort(steps.begin(), steps.end(), [](const ChargeStep& a, const ChargeStep& b) {
+                return a.margin > b.margin;
+            });
+            mChargeSteps[zone] = steps;
+        } else if (key == "tune") {
+            // "zone" is the profile name here.
+            std::string type, attribute, value;
+            if (!(in >> type >> attribute >> value)) {
+                ALOGE("%s: %s:%d: expected a zone, attribute and value", __func__, path.c_str(),
+                      lineno);
+                continue;
+            }
+            const auto end = kTuningAttributes + kNumTuningAttributes;
+            const auto it = std::find_if(kTuningAttributes, end, [&attribute](const char *a) {
+                return attribute == a;
+            });
+            if (it == end) {
+                ALOGE("%s: %s:%d: cannot tune %s", __func__, path.c_str(), lineno,
+                      attribute.c_str());
+                continue;
+            }
+            mTuningProfiles[zone][type][it - kTuningAttributes] = value;
+        } else {
+            ALOGE("%s: %s:%d: unknown key %s", __func__, path.c_str(), lineno, key.c_str());
+        }
+    }
+    return true;
+}
+
+const ZoneConfig& ThermalConfig::zone(const std::string& type) const {
+    auto it = mZones.find(type);
+    return it != mZones.end() ? it->second : mZones.at(DEFAULT_ZONE);
+}
+
+const std::vector<ChargeStep>& ThermalConfig::chargeSteps(const std::string& supply) const {
+    static const std::vector<ChargeStep> kNone;
+    auto it = mChargeSteps.find(supply);
+    if (it == mChargeSteps.end()) {
+        it = mChargeSteps.find(DEFAULT_ZONE);
+    }
+    return it != mChargeSteps.end() ? it->second : kNone;
+}
+
+const TuningProfile *ThermalConfig::tuningProfile(const std::string& name) const {
+    auto it = mTuningProfiles.find(name);
+    return it != mTuningProfiles.end() ? &it->second : nullptr;
+}
+
+std::vector<std::string> ThermalConfig::tuningProfileNames() const {
+    std::vector<std::string> names;
+    for (const auto& profile : mTuningProfiles) {
+        names.push_back(profile.first);
+    }
+    return names;
+}
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ANDROID_HARDWARE_THERMAL_V1_1_THERMALCONFIG_H
+#define ANDROID_HARDWARE_THERMAL_V1_1_THERMALCONFIG_H
+
+#include <array>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "SeverityEngine.h"
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+struct ZoneConfig {
+    SeverityThresholds hot;
+    SeverityThresholds cold;
+    // Polling period of zones without a trip window, 0 for the default.
+    uint32_t periodMs = 0;
+};
+
+constexpr size_t kNumTuningAttributes = 9;
+
+// Files of a zone directory that tuning profiles may write, in the order
+// they are written: the governor comes first since binding one resets its
+// parameters, and sustainable_power before the k_* terms derived from it.
+extern const char *const kTuningAttributes[kNumTuningAttributes];
+
+// Values indexed like kTuningAttributes; empty leaves a file alone.
+using TuningValues = std::array<std::string, kNumTuningAttributes>;
+
+// Kernel settings for one use case, by zone type; "*" applies to every zone
+// and a zone's own entry overrides it file by file.
+using TuningProfile = std::map<std::string, TuningValues>;
+
+// Charge current limit that applies once some zone is within margin
+// degrees Celsius of its first hot threshold.
+struct ChargeStep {
+    float margin;
+    uint32_t percent;
+};
+
+// Per-zone settings read from a line based file. Zones are keyed by their
+// type; "*" applies to every zone without its own entry.
+class ThermalConfig {
+  public:
+    explicit ThermalConfig(const ZoneConfig& defaults);
+
+    // Returns false if the file cannot be read; malformed lines are skipped.
+    bool load(const std::string& path);
+    void set(const std::string& type, const ZoneConfig& config) { mZones[type] = config; }
+
+    const ZoneConfig& zone(const std::string& type) const;
+
+    // Steps for a power supply, by decreasing margin; empty if charging is
+    // never limited.
+    const std::vector<ChargeStep>& chargeSteps(const std::string& supply) const;
+
+    // Returns null if no profile has that name.
+    const TuningProfile *tuningProfile(const std::string& name) const;
+    std::vector<std::string> tuningProfileNames() const;
+
+  private:
+    std::map<std::string, ZoneConfig> mZones;
+    std::map<std::string, std::vector<ChargeStep>> mChargeSteps;
+    std::map<std::string, TuningProfile> mTuningProfiles;
+};
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
+
+#endif  // ANDROID_HARDWARE_THERMAL_V1_1_THERMALCONFIG_H
@@ -0,0 +1,313 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "ThermalHAL"
+
+#include <errno.h>
+#include <math.h>
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+
+#include <log/log.h>
+
+#include "ThermalExt.h"
+
+// Deliveries due within this fraction of a period are sent on the current
+// sampling round rather than one round late.
+#define DELIVERY_SLACK_DIVISOR  4
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+static uint8_t thresholdBand(const std::vector<float>& thresholds, float temperature) {
+    return std::upper_bound(thresholds.begin(), thresholds.end(), temperature) -
+           thresholds.begin();
+}
+
+ThermalExt::ThermalExt(const sp<Thermal>& thermal) : mThermal(thermal) {
+    mThermal->watcher()->setSampleListener(
+            [this](int64_t nowNs, const std::vector<float>& temperatures) {
+                onSample(nowNs, temperatures);
+            });
+    mThermal->watcher()->setTableListener(
+            [this](const std::shared_ptr<const ThermalWatcher::ZoneTable>& table) {
+                onTableChanged(table);
+            });
+}
+
+void ThermalExt::resolve(const ThermalWatcher::ZoneTable& table, Client* client) {
+    // Zones that stay selected keep their band so that a table change alone
+    // never looks like a crossing.
+    std::vector<size_t> zones;
+    std::vector<uint8_t> bands;
+    for (size_t i : table.live) {
+        const auto& zone = table.zones[i];
+        if (!client->names.empty() &&
+            std::find(client->names.begin(), client->names.end(), zone.name) ==
+                    client->names.end()) {
+            continue;
+        }
+        auto it = std::find(client->zones.begin(), client->zones.end(), i);
+        zones.push_back(i);
+        bands.push_back(it != client->zones.end() ? client->bands[it - client->zones.begin()] : 0);
+    }
+    client->zones = std::move(zones);
+    client->bands = std::move(bands);
+}
+
+Return<void> ThermalExt::subscribe(const Subscription& subscription,
+                                   const sp<IThermalExtCallback>& callback,
+                                   subscribe_cb _hidl_cb) {
+    Thermal::CallScope scope(mThermal.get(), ThermalMetrics::EXT_SUBSCRIBE);
+    ThermalStatus status;
+    status.code = V1_0::ThermalStatusCode::SUCCESS;
+
+    Client client;
+    client.callback = callback;
+    client.periodNs = subscription.periodMs * 1000000LL;
+    client.nextNs = 0;
+    client.thresholds = subscription.thresholds;
+    std::sort(client.thresholds.begin(), client.thresholds.end());
+
+    for (const auto& name : subscription.zones) {
+        client.names.push_back(name);
+    }
+    if (callback == nullptr || client.periodNs == 0) {
+        status.code = V1_0::ThermalStatusCode::FAILURE;
+        status.debugMessage = strerror(EINVAL);
+        _hidl_cb(status, 0);
+        return Void();
+    }
+
+    // The table is taken under mLock so that a table published meanwhile is
+    // either seen here or re-resolved by onTableChanged() afterwards.
+    std::vector<int64_t> periods;
+    int error = 0;
+    {
+        std::lock_guard<std::mutex> _lock(mLock);
+        const auto table = mThermal->watcher()->zoneTable();
+        if (table == nullptr) {
+            error = ENOENT;
+        } else {
+            resolve(*table, &client);
+            error = client.zones.empty() ? EINVAL : 0;
+        }
+        if (error == 0) {
+            client.id = mNextId++;
+            mClients.push_back(client);
+            periods = requestedPeriods(table->zones.size());
+        }
+    }
+    if (error != 0) {
+        status.code = V1_0::ThermalStatusCode::FAILURE;
+        status.debugMessage = strerror(error);
+        _hidl_cb(status, 0);
+        return Void();
+    }
+    mThermal->watcher()->setRequestedPeriods(periods);
+
+    _hidl_cb(status, client.id);
+    return Void();
+}
+
+Return<void> ThermalExt::getTemperaturesFiltered(const TemperatureFilter& filter,
+                                                 getTemperaturesFiltered_cb _hidl_cb) {
+    Thermal::CallScope scope(mThermal.get(), ThermalMetrics::EXT_GET_TEMPERATURES_FILTERED);
+    ThermalStatus status;
+    status.code = V1_0::ThermalStatusCode::SUCCESS;
+    std::vector<Temperature> temperatures;
+
+    const auto table = mThermal->watcher()->zoneTable();
+    if (table == nullptr) {
+        status.code = V1_0::ThermalStatusCode::FAILURE;
+        status.debugMessage = strerror(ENOENT);
+        _hidl_cb(status, temperatures);
+        return Void();
+    }
+
+    // The 1.0 types number CPU to SKIN like ZoneClass.
+    const int32_t type = static_cast<int32_t>(filter.type);
+    const ZoneClass zoneClass = type >= 0 && type <= static_cast<int32_t>(ZoneClass::SKIN)
+            ? static_cast<ZoneClass>(type)
+            : ZoneClass::UNKNOWN;
+    std::vector<std::string> names(filter.names.begin(), filter.names.end());
+    std::vector<Thermal::ZoneReading> readings;
+    mThermal->readZones(*table, table->select(filter.filterType ? &zoneClass : nullptr, names),
+                        filter.cached, &readings);
+    temperatures.reserve(readings.size());
+    for (const auto& reading : readings) {
+        const auto& zone = table->zones[reading.zone];
+        temperatures.push_back(mThermal->makeTemperature(zone.name, reading.temperature,
+                                                         zone.zoneClass));
+    }
+
+    if (temperatures.empty()) {
+        status.code = V1_0::ThermalStatusCode::FAILURE;
+        status.debugMessage = strerror(ENOENT);
+    }
+    hidl_vec<Temperature> reply;
+    reply.setToExternal(temperatures.data(), temperatures.size());
+    _hidl_cb(status, reply);
+    return Void();
+}
+
+Return<ThermalStatus> ThermalExt::unsubscribe(uint32_t id) {
+    Thermal::CallScope scope(mThermal.get(), ThermalMetrics::EXT_UNSUBSCRIBE);
+    ThermalStatus status;
+    status.code = V1_0::ThermalStatusCode::SUCCESS;
+
+    std::vector<int64_t> periods;
+    {
+        std::lock_guard<std::mutex> _lock(mLock);
+        auto it = std::find_if(mClients.begin(), mClients.end(),
+                               [id](const Client& c) { return c.id == id; });
+        if (it == mClients.end()) {
+            status.code = V1_0::ThermalStatusCode::FAILURE;
+            status.debugMessage = strerror(ENOENT);
+            return status;
+        }
+        mClients.erase(it);
+        periods = requestedPeriods();
+    }
+    mThermal->watcher()->setRequestedPeriods(periods);
+    return status;
+}
+
+Return<ThermalStatus> ThermalExt::setTuningProfile(const hidl_string& profile) {
+    Thermal::CallScope scope(mThermal.get(), ThermalMetrics::EXT_SET_TUNING_PROFILE);
+    ThermalStatus status;
+    status.code = V1_0::ThermalStatusCode::SUCCESS;
+    if (mThermal->tuning() == nullptr) {
+        status.code = V1_0::ThermalStatusCode::FAILURE;
+        status.debugMessage = strerror(ENOENT);
+    } else if (!mThermal->tuning()->apply(profile, "IThermalExt")) {
+        status.code = V1_0::ThermalStatusCode::FAILURE;
+        status.debugMessage = strerror(EIO);
+    }
+    return status;
+}
+
+std::vector<int64_t> ThermalExt::requestedPeriods() {
+    const auto table = mThermal->watcher()->zoneTable();
+    return requestedPeriods(table != nullptr ? table->zones.size() : 0);
+}
+
+std::vector<int64_t> ThermalExt::requestedPeriods(size_t zoneCount) {
+    std::vector<int64_t> periods(zoneCount, 0);
+    for (const auto& client : mClients) {
+        for (size_t zone : client.zones) {
+            if (zone < zoneCount && (periods[zone] == 0 || client.periodNs < periods[zone])) {
+                periods[zone] = client.periodNs;
+            }
+        }
+    }
+    return periods;
+}
+
+void ThermalExt::onTableChanged(const std::shared_ptr<const ThermalWatcher::ZoneTable>& table) {
+    std::vector<int64_t> periods;
+    {
+        std::lock_guard<std::mutex> _lock(mLock);
+        if (mClients.empty()) {
+            return;
+        }
+        for (auto& client : mClients) {
+            resolve(*table, &client);
+        }
+        periods = requestedPeriods(table->zones.size());
+    }
+    mThermal->watcher()->setRequestedPeriods(periods);
+}
+
+void ThermalExt::onSample(int64_t nowNs, const std::vector<float>& temperatures) {
+    const auto table = mThermal->watcher()->zoneTable();
+    if (table == nullptr) {
+        return;
+    }
+    std::vector<std::pair<sp<IThermalExtCallback>, hidl_vec<Temperature>>> deliveries;
+    {
+        std::lock_guard<std::mutex> _lock(mLock);
+        for (auto& client : mClients) {
+            if (client.zones.empty()) {
+                continue;
+            }
+            bool crossed = false;
+            for (size_t i = 0; i < client.zones.size(); ++i) {
+                // A zone that could not be read keeps its band, or one that
+                // reads every other round would cross each time.
+                const float temperature = temperatures[client.zones[i]];
+                if (isnan(temperature)) {
+                    continue;
+                }
+                const uint8_t band = thresholdBand(client.thresholds, temperature);
+                crossed |= band != client.bands[i];
+                client.bands[i] = band;
+            }
+
+            const bool due = nowNs + client.periodNs / DELIVERY_SLACK_DIVISOR >= client.nextNs;
+            if (!due && !crossed) {
+                continue;
+            }
+            if (due) {
+                client.nextNs += client.periodNs;
+                if (client.nextNs <= nowNs) {
+                    client.nextNs = nowNs + client.periodNs;
+                }
+            }
+
+            hidl_vec<Temperature> reply;
+            reply.resize(client.zones.size());
+            for (size_t i = 0; i < client.zones.size(); ++i) {
+                const size_t zone = client.zones[i];
+                reply[i] = mThermal->makeTemperature(table->zones[zone].name,
+                                                     temperatures[zone],
+                                                     table->zones[zone].zoneClass);
+            }
+            deliveries.emplace_back(client.callback, std::move(reply));
+        }
+    }
+
+    for (const auto& delivery : deliveries) {
+        auto ret = delivery.first->notifyTemperatures(delivery.second);
+        if (ret.isOk() || !ret.isDeadObject()) {
+            continue;
+        }
+
+        std::vector<int64_t> periods;
+        {
+            std::lock_guard<std::mutex> _lock(mLock);
+            mClients.erase(std::remove_if(mClients.begin(), mClients.end(),
+                                          [&delivery](const Client& c) {
+                                              return c.callback == delivery.first;
+                                          }),
+                           mClients.end());
+            periods = requestedPeriods();
+        }
+        mThermal->watcher()->setRequestedPeriods(periods);
+        ALOGI("%s: dropped dead subscriber", __func__);
+    }
+}
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
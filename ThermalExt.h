@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ANDROID_HARDWARE_THERMAL_V1_1_THERMALEXT_H
+#define ANDROID_HARDWARE_THERMAL_V1_1_THERMALEXT_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <vendor/renesas/hardware/thermal/1.0/IThermalExt.h>
+
+#include "Thermal.h"
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+using ::vendor::renesas::hardware::thermal::V1_0::IThermalExt;
+using ::vendor::renesas::hardware::thermal::V1_0::IThermalExtCallback;
+using ::vendor::renesas::hardware::thermal::V1_0::Subscription;
+using ::vendor::renesas::hardware::thermal::V1_0::TemperatureFilter;
+
+struct ThermalExt : public IThermalExt {
+    explicit ThermalExt(const sp<Thermal>& thermal);
+
+    // Methods from ::vendor::renesas::hardware::thermal::V1_0::IThermalExt follow.
+    Return<void> subscribe(const Subscription& subscription,
+                           const sp<IThermalExtCallback>& callback, subscribe_cb _hidl_cb) override;
+    Return<ThermalStatus> unsubscribe(uint32_t id) override;
+    Return<void> getTemperaturesFiltered(const TemperatureFilter& filter,
+                                         getTemperaturesFiltered_cb _hidl_cb) override;
+    Return<ThermalStatus> setTuningProfile(const hidl_string& profile) override;
+
+  private:
+    struct Client {
+        uint32_t id;
+        sp<IThermalExtCallback> callback;
+        // Zone names asked for, empty for every zone.
+        std::vector<std::string> names;
+        // Live zones matching names in the current table.
+        std::vector<size_t> zones;
+        int64_t periodNs;
+        int64_t nextNs;
+        // Sorted, with the number of thresholds at or below each selected
+        // zone's last temperature.
+        std::vector<float> thresholds;
+        std::vector<uint8_t> bands;
+    };
+
+    // Selects the zones of client from table.
+    static void resolve(const ThermalWatcher::ZoneTable& table, Client* client);
+    void onSample(int64_t nowNs, const std::vector<float>& temperatures);
+    void onTableChanged(const std::shared_ptr<const ThermalWatcher::ZoneTable>& table);
+    // Merges the periods of all clients into one request per zone. Called
+    // with mLock held.
+    std::vector<int64_t> requestedPeriods();
+    std::vector<int64_t> requestedPeriods(size_t zoneCount);
+
+    const sp<Thermal> mThermal;
+    std::mutex mLock;
+    std::vector<Client> mClients;
+    uint32_t mNextId = 1;
+};
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
+
+#endif  // ANDROID_HARDWARE_THERMAL_V1_1_THERMALEXT_H
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "ThermalHAL"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <vector>
+
+#include <android-base/unique_fd.h>
+#include <log/log.h>
+
+#include "ThermalJournal.h"
+
+#define JOURNAL_MAGIC           0x4a544853  // "SHTJ"
+#define JOURNAL_VERSION         1
+#define JOURNAL_SIZE            (sizeof(Header) + kJournalCapacity * sizeof(Record))
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+ThermalJournal::~ThermalJournal() {
+    if (mHeader != nullptr) {
+        munmap(mHeader, JOURNAL_SIZE);
+    }
+}
+
+bool ThermalJournal::open(const std::string& path) {
+    std::lock_guard<std::mutex> _lock(mLock);
+    ::android::base::unique_fd fd(
+            TEMP_FAILURE_RETRY(::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0660)));
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 ||
+        (st.st_size != static_cast<off_t>(JOURNAL_SIZE) && ftruncate(fd, JOURNAL_SIZE) != 0)) {
+        ALOGE("%s: failed to open %s: %s", __func__, path.c_str(), strerror(errno));
+        fd.reset();
+    }
+
+    void *map = mmap(nullptr, JOURNAL_SIZE, PROT_READ | PROT_WRITE,
+                     fd >= 0 ? MAP_SHARED : MAP_PRIVATE | MAP_ANONYMOUS, fd, 0);
+    if (map == MAP_FAILED) {
+        ALOGE("%s: failed to map journal: %s", __func__, strerror(errno));
+        return false;
+    }
+
+    mHeader = static_cast<Header *>(map);
+    mRecords = reinterpret_cast<Record *>(mHeader + 1);
+    if (mHeader->magic != JOURNAL_MAGIC || mHeader->version != JOURNAL_VERSION ||
+        mHeader->capacity != kJournalCapacity) {
+        memset(map, 0, JOURNAL_SIZE);
+        mHeader->magic = JOURNAL_MAGIC;
+        mHeader->version = JOURNAL_VERSION;
+        mHeader->capacity = kJournalCapacity;
+    }
+    return fd >= 0;
+}
+
+void ThermalJournal::append(const Record& record) {
+    std::lock_guard<std::mutex> _lock(mLock);
+    if (mHeader == nullptr) {
+        return;
+    }
+    mRecords[mHeader->next % kJournalCapacity] = record;
+    mHeader->next++;
+}
+
+void ThermalJournal::dump(int fd) {
+    // Copied first so that the watcher never waits on the reader.
+    std::vector<Record> records;
+    uint32_t next;
+    {
+        std::lock_guard<std::mutex> _lock(mLock);
+        if (mHeader == nullptr) {
+            return;
+        }
+        next = mHeader->next;
+        records.assign(mRecords, mRecords + kJournalCapacity);
+    }
+
+    const uint32_t count = next < kJournalCapacity ? next : kJournalCapacity;
+    dprintf(fd, "ThermalJournal: %u of %u events\n", count, next);
+    for (uint32_t i = next - count; i != next; ++i) {
+        const Record& r = records[i % kJournalCapacity];
+        char date[32];
+        time_t seconds = r.realtimeMs / 1000;
+        struct tm tm;
+        strftime(date, sizeof(date), "%m-%d %H:%M:%S", localtime_r(&seconds, &tm));
+        dprintf(fd, "  %s.%03" PRId64 " %s %.1f C %+.2f C/s %s -> %s (device %s) caps", date,
+                r.realtimeMs % 1000, r.zone, r.temperature, r.slope,
+                toString(static_cast<SeverityLevel>(r.from)),
+                toString(static_cast<SeverityLevel>(r.to)),
+                toString(static_cast<SeverityLevel>(r.deviceLevel)));
+        for (uint8_t a = 0; a < r.actuatorCount; ++a) {
+            dprintf(fd, " %u", r.actuatorStates[a]);
+        }
+        dprintf(fd, "\n");
+    }
+}
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ANDROID_HARDWARE_THERMAL_V1_1_THERMALJOURNAL_H
+#define ANDROID_HARDWARE_THERMAL_V1_1_THERMALJOURNAL_H
+
+#include <stdint.h>
+
+#include <mutex>
+#include <string>
+
+#include "SeverityEngine.h"
+#include "ThermalSnapshot.h"
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+constexpr size_t kJournalCapacity = 256;
+
+// Fixed-size ring of severity transitions. Records live in a file mapped
+// shared, so appending is a memory copy and the last kJournalCapacity
+// events are left on disk for post-mortem analysis.
+class ThermalJournal {
+  public:
+    struct Record {
+        int64_t bootNs;
+        int64_t realtimeMs;
+        char zone[kSnapshotNameLength];
+        float temperature;
+        // Degrees Celsius per second since the previous reading of the zone.
+        float slope;
+        uint8_t from;
+        uint8_t to;
+        uint8_t deviceLevel;
+        uint8_t actuatorCount;
+        uint8_t actuatorStates[kMaxSnapshotActuators];
+        uint8_t reserved[4];
+    };
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t capacity;
+        uint32_t next;
+    };
+
+    ThermalJournal() = default;
+    ~ThermalJournal();
+    ThermalJournal(const ThermalJournal&) = delete;
+    ThermalJournal& operator=(const ThermalJournal&) = delete;
+
+    // Keeps the records of a previous run. Falls back to an anonymous
+    // mapping when path cannot be used.
+    bool open(const std::string& path);
+
+    void append(const Record& record);
+    void dump(int fd);
+
+  private:
+    std::mutex mLock;
+    Header *mHeader = nullptr;
+    Record *mRecords = nullptr;
+};
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
+
+#endif  // ANDROID_HARDWARE_THERMAL_V1_1_THERMALJOURNAL_H
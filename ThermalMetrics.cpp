@@ -0,0 +1,318 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "ThermalHAL"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <math.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <android-base/stringprintf.h>
+#include <log/log.h>
+
+#include "ThermalMetrics.h"
+
+#define METRICS_BACKLOG         4
+#define METRICS_REQUEST_SIZE    1024
+#define METRICS_REQUEST_WAIT_MS 100
+#define METRICS_CLIENT_WAIT_MS  1000
+#define METRICS_BACKOFF_US      100000
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+using ::android::base::StringAppendF;
+
+// Upper bounds of the call duration buckets; the last bucket is +Inf.
+static const int64_t kBucketBoundsNs[] = {
+    50000, 100000, 250000, 500000, 1000000, 2500000, 5000000, 10000000, 25000000,
+};
+
+static const char *kCallNames[ThermalMetrics::kNumCalls] = {
+    "getTemperatures", "getCpuUsages", "getCoolingDevices", "registerThermalCallback",
+    "getCurrentTemperatures", "getTemperatureThresholds", "registerThermalChangedCallback",
+    "unregisterThermalChangedCallback", "getCurrentCoolingDevices",
+    "aidl/getTemperatures", "aidl/getTemperatureThresholds", "aidl/getCoolingDevices",
+    "aidl/registerThermalChangedCallback", "aidl/unregisterThermalChangedCallback",
+    "ext/subscribe", "ext/unsubscribe", "ext/getTemperaturesFiltered", "ext/setTuningProfile",
+};
+
+static void appendMetric(std::string* out, const char *name, const char *type,
+                         const char *help) {
+    StringAppendF(out, "# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+}
+
+static void appendValue(std::string* out, double value) {
+    if (isnan(value)) {
+        out->append(" NaN\n");
+    } else {
+        StringAppendF(out, " %.9g\n", value);
+    }
+}
+
+ThermalMetrics::ThermalMetrics(ThermalSnapshot& snapshot) : Thread(false), mSnapshot(snapshot) {
+    static_assert(sizeof(kBucketBoundsNs) / sizeof(kBucketBoundsNs[0]) + 1 == kNumBuckets,
+                  "one bucket per bound plus +Inf");
+}
+
+const char *ThermalMetrics::callName(Call call) {
+    return call < kNumCalls ? kCallNames[call] : "unknown";
+}
+
+void ThermalMetrics::recordCall(Call call, int64_t durationNs) {
+    size_t bucket = 0;
+    while (bucket < kNumBuckets - 1 && durationNs > kBucketBoundsNs[bucket]) {
+        ++bucket;
+    }
+    mBuckets[call][bucket].fetch_add(1, std::memory_order_relaxed);
+    mSumNs[call].fetch_add(durationNs, std::memory_order_relaxed);
+}
+
+bool ThermalMetrics::startServing(int socketFd, const CpuReader& cpuReader,
+                                  const CpuIdleReader& cpuIdleReader) {
+    mSocket.reset(socketFd);
+    mCpuReader = cpuReader;
+    mCpuIdleReader = cpuIdleReader;
+    if (listen(mSocket, METRICS_BACKLOG) != 0) {
+        ALOGE("%s: failed to listen: %s", __func__, strerror(errno));
+        mSocket.reset();
+        return false;
+    }
+    return run("ThermalMetrics", PRIORITY_BACKGROUND) == NO_ERROR;
+}
+
+std::string ThermalMetrics::render() {
+    std::string out;
+    std::string snapshot;
+    if (mSnapshot.copy(&snapshot)) {
+        const auto *header = reinterpret_cast<const ThermalSnapshot::Header *>(snapshot.data());
+        const auto *zones = reinterpret_cast<const ThermalSnapshot::Zone *>(header + 1);
+        const auto *actuators =
+                reinterpret_cast<const ThermalSnapshot::Actuator *>(zones + header->zoneCount);
+
+        appendMetric(&out, "thermal_zone_temperature_celsius", "gauge",
+                     "Last sampled zone temperature.");
+        for (size_t z = 0; z < header->zoneCount; ++z) {
+            StringAppendF(&out, "thermal_zone_temperature_celsius{zone=\"%s\"}", zones[z].name);
+            appendValue(&out, zones[z].temperature);
+        }
+        appendMetric(&out, "thermal_zone_severity_level", "gauge",
+                     "Current severity level of the zone, 0 (NONE) to 5 (EMERGENCY).");
+        for (size_t z = 0; z < header->zoneCount; ++z) {
+            StringAppendF(&out, "thermal_zone_severity_level{zone=\"%s\"} %u\n", zones[z].name,
+                          zones[z].level);
+        }
+        appendMetric(&out, "thermal_zone_level_seconds_total", "counter",
+                     "Time each zone spent at each severity level.");
+        for (size_t z = 0; z < header->zoneCount; ++z) {
+            for (size_t l = 0; l < kNumSeverityLevels; ++l) {
+                StringAppendF(&out, "thermal_zone_level_seconds_total{zone=\"%s\",level=\"%s\"}",
+                              zones[z].name, toString(static_cast<SeverityLevel>(l)));
+                appendValue(&out, zones[z].levelNs[l] / 1e9);
+            }
+        }
+        appendMetric(&out, "thermal_zone_band_seconds_total", "counter",
+                     "Time each zone spent in each temperature band.");
+        for (size_t z = 0; z < header->zoneCount; ++z) {
+            for (size_t b = 0; b < kNumTemperatureBands; ++b) {
+                StringAppendF(&out, "thermal_zone_band_seconds_total{zone=\"%s\",band=\"%s\"}",
+                              zones[z].name, ThermalSnapshot::bandName(b));
+                appendValue(&out, zones[z].bandNs[b] / 1e9);
+            }
+        }
+        appendMetric(&out, "thermal_device_severity_level", "gauge",
+                     "Highest severity level over all zones.");
+        StringAppendF(&out, "thermal_device_severity_level %u\n", header->deviceLevel);
+        appendMetric(&out, "thermal_device_level_seconds_total", "counter",
+                     "Time the device spent at each severity level.");
+        for (size_t l = 0; l < kNumSeverityLevels; ++l) {
+            StringAppendF(&out, "thermal_device_level_seconds_total{level=\"%s\"}",
+                          toString(static_cast<SeverityLevel>(l)));
+            appendValue(&out, header->deviceLevelNs[l] / 1e9);
+        }
+        appendMetric(&out, "thermal_cooling_state", "gauge", "Current cooling device state.");
+        for (size_t a = 0; a < header->actuatorCount; ++a) {
+            StringAppendF(&out, "thermal_cooling_state{device=\"%s\"} %u\n", actuators[a].name,
+                          actuators[a].state);
+        }
+        appendMetric(&out, "thermal_cooling_state_seconds_total", "counter",
+                     "Time each cooling device spent in each state.");
+        for (size_t a = 0; a < header->actuatorCount; ++a) {
+            for (size_t s = 0; s < kMaxActuatorStates; ++s) {
+                if (actuators[a].stateNs[s] == 0) {
+                    continue;
+                }
+                StringAppendF(&out, "thermal_cooling_state_seconds_total{device=\"%s\","
+                              "state=\"%zu\"}", actuators[a].name, s);
+                appendValue(&out, actuators[a].stateNs[s] / 1e9);
+            }
+        }
+        if (header->gpu.freqHz != 0) {
+            appendMetric(&out, "thermal_gpu_frequency_hz", "gauge", "Current GPU frequency.");
+            StringAppendF(&out, "thermal_gpu_frequency_hz %" PRIu64 "\n", header->gpu.freqHz);
+        }
+        if (header->gpu.totalNs != 0) {
+            appendMetric(&out, "thermal_gpu_busy_seconds_total", "counter",
+                         "Time the GPU was busy, as reported by devfreq.");
+            out += "thermal_gpu_busy_seconds_total";
+            appendValue(&out, header->gpu.busyNs / 1e9);
+            appendMetric(&out, "thermal_gpu_seconds_total", "counter",
+                         "Time over which GPU load was sampled.");
+            out += "thermal_gpu_seconds_total";
+            appendValue(&out, header->gpu.totalNs / 1e9);
+        }
+    }
+
+    std::vector<V1_0::CpuUsage> cpuUsages;
+    if (mCpuReader && mCpuReader(&cpuUsages)) {
+        appendMetric(&out, "thermal_cpu_active_jiffies_total", "counter",
+                     "Jiffies each CPU spent in user, nice and system time.");
+        for (const auto& usage : cpuUsages) {
+            StringAppendF(&out, "thermal_cpu_active_jiffies_total{cpu=\"%s\"} %" PRIu64 "\n",
+                          usage.name.c_str(), usage.active);
+        }
+        appendMetric(&out, "thermal_cpu_jiffies_total", "counter",
+                     "Jiffies each CPU spent active or idle.");
+        for (const auto& usage : cpuUsages) {
+            StringAppendF(&out, "thermal_cpu_jiffies_total{cpu=\"%s\"} %" PRIu64 "\n",
+                          usage.name.c_str(), usage.total);
+        }
+        appendMetric(&out, "thermal_cpu_online", "gauge", "Whether the CPU is online.");
+        for (const auto& usage : cpuUsages) {
+            StringAppendF(&out, "thermal_cpu_online{cpu=\"%s\"} %d\n", usage.name.c_str(),
+                          usage.isOnline ? 1 : 0);
+        }
+    }
+
+    std::vector<CpuIdleTotal> idleTotals;
+    std::vector<float> busy;
+    if (mCpuIdleReader && mCpuIdleReader(&idleTotals, &busy)) {
+        appendMetric(&out, "thermal_cpu_busy_ratio", "gauge",
+                     "Share of the last cpuidle window each CPU spent out of idle.");
+        for (size_t cpu = 0; cpu < busy.size(); ++cpu) {
+            if (!isnan(busy[cpu])) {
+                StringAppendF(&out, "thermal_cpu_busy_ratio{cpu=\"CPU%zu\"}", cpu);
+                appendValue(&out, busy[cpu]);
+            }
+        }
+        appendMetric(&out, "thermal_cpu_idle_seconds_total", "counter",
+                     "Time each CPU spent in each cpuidle state.");
+        for (const auto& total : idleTotals) {
+            StringAppendF(&out, "thermal_cpu_idle_seconds_total{cpu=\"CPU%d\",state=\"%s\"}",
+                          total.cpu, total.state.c_str());
+            appendValue(&out, total.timeUs / 1e6);
+        }
+        appendMetric(&out, "thermal_cpu_idle_entries_total", "counter",
+                     "Times each CPU entered each cpuidle state.");
+        for (const auto& total : idleTotals) {
+            StringAppendF(&out,
+                          "thermal_cpu_idle_entries_total{cpu=\"CPU%d\",state=\"%s\"} %" PRIu64
+                          "\n", total.cpu, total.state.c_str(), total.usage);
+        }
+    }
+
+    appendMetric(&out, "thermal_hal_call_duration_seconds", "histogram",
+                 "Time spent in each HAL method.");
+    for (size_t c = 0; c < kNumCalls; ++c) {
+        uint64_t count = 0;
+        for (size_t b = 0; b < kNumBuckets; ++b) {
+            count += mBuckets[c][b].load(std::memory_order_relaxed);
+            if (b < kNumBuckets - 1) {
+                StringAppendF(&out, "thermal_hal_call_duration_seconds_bucket{method=\"%s\","
+                              "le=\"%g\"} %" PRIu64 "\n", kCallNames[c],
+                              kBucketBoundsNs[b] / 1e9, count);
+            } else {
+                StringAppendF(&out, "thermal_hal_call_duration_seconds_bucket{method=\"%s\","
+                              "le=\"+Inf\"} %" PRIu64 "\n", kCallNames[c], count);
+            }
+        }
+        StringAppendF(&out, "thermal_hal_call_duration_seconds_sum{method=\"%s\"}",
+                      kCallNames[c]);
+        appendValue(&out, mSumNs[c].load(std::memory_order_relaxed) / 1e9);
+        StringAppendF(&out, "thermal_hal_call_duration_seconds_count{method=\"%s\"} %" PRIu64
+                      "\n", kCallNames[c], count);
+    }
+    return out;
+}
+
+bool ThermalMetrics::threadLoop() {
+    ::android::base::unique_fd client(TEMP_FAILURE_RETRY(accept4(mSocket, nullptr, nullptr,
+                                                                 SOCK_CLOEXEC)));
+    if (client < 0) {
+        const int error = errno;
+        ALOGE("%s: failed to accept: %s", __func__, strerror(error));
+        // Only a socket that is not listening any more is hopeless; a
+        // client that gave up or a full descriptor table is not.
+        if (error == EBADF || error == EINVAL || error == ENOTSOCK) {
+            return false;
+        }
+        if (error == EMFILE || error == ENFILE || error == ENOBUFS || error == ENOMEM) {
+            usleep(METRICS_BACKOFF_US);
+        }
+        return true;
+    }
+    // One thread serves every client, so a client that stops reading or
+    // writing must not hold it for longer than this.
+    const struct timeval timeout = {METRICS_CLIENT_WAIT_MS / 1000,
+                                    (METRICS_CLIENT_WAIT_MS % 1000) * 1000};
+    setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    // Plain clients send nothing and get the bare text; an HTTP scraper
+    // sends a GET first and gets a response it can parse.
+    char request[METRICS_REQUEST_SIZE];
+    ssize_t length = 0;
+    struct pollfd pfd = {client, POLLIN, 0};
+    if (TEMP_FAILURE_RETRY(poll(&pfd, 1, METRICS_REQUEST_WAIT_MS)) > 0) {
+        length = TEMP_FAILURE_RETRY(read(client, request, sizeof(request)));
+    }
+
+    const std::string body = render();
+    std::string response;
+    if (length >= 4 && !strncmp(request, "GET ", 4)) {
+        response = ::android::base::StringPrintf(
+                "HTTP/1.0 200 OK\r\n"
+                "Content-Type: text/plain; version=0.0.4\r\n"
+                "Content-Length: %zu\r\n\r\n", body.size());
+    }
+    response += body;
+    // send() rather than write() so that a client hanging up early does not
+    // raise SIGPIPE in the service.
+    for (size_t sent = 0; sent < response.size();) {
+        const ssize_t n = TEMP_FAILURE_RETRY(send(client, response.data() + sent,
+                                                  response.size() - sent, MSG_NOSIGNAL));
+        if (n <= 0) {
+            ALOGW("%s: client went away: %s", __func__, strerror(errno));
+            break;
+        }
+        sent += n;
+    }
+    return true;
+}
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
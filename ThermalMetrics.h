@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ANDROID_HARDWARE_THERMAL_V1_1_THERMALMETRICS_H
+#define ANDROID_HARDWARE_THERMAL_V1_1_THERMALMETRICS_H
+
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <android/hardware/thermal/1.0/types.h>
+#include <android-base/unique_fd.h>
+#include <utils/Thread.h>
+
+#include "CpuIdle.h"
+#include "ThermalSnapshot.h"
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+// Serves the snapshot, CPU usage and call latencies in the Prometheus text
+// exposition format to every client that connects to a local socket. Zone
+// data comes from the snapshot, so a scrape never touches sysfs.
+class ThermalMetrics : public ::android::Thread {
+  public:
+    enum Call {
+        GET_TEMPERATURES,
+        GET_CPU_USAGES,
+        GET_COOLING_DEVICES,
+        REGISTER_THERMAL_CALLBACK,
+        // android.hardware.thermal@2.0
+        GET_CURRENT_TEMPERATURES,
+        GET_TEMPERATURE_THRESHOLDS,
+        REGISTER_THERMAL_CHANGED_CALLBACK,
+        UNREGISTER_THERMAL_CHANGED_CALLBACK,
+        GET_CURRENT_COOLING_DEVICES,
+        // AIDL android.hardware.thermal; the WithType variants count with
+        // the plain methods.
+        AIDL_GET_TEMPERATURES,
+        AIDL_GET_TEMPERATURE_THRESHOLDS,
+        AIDL_GET_COOLING_DEVICES,
+        AIDL_REGISTER_CALLBACK,
+        AIDL_UNREGISTER_CALLBACK,
+        // vendor.renesas.hardware.thermal@1.0::IThermalExt
+        EXT_SUBSCRIBE,
+        EXT_UNSUBSCRIBE,
+        EXT_GET_TEMPERATURES_FILTERED,
+        EXT_SET_TUNING_PROFILE,
+        kNumCalls,
+    };
+
+    using CpuReader = std::function<bool(std::vector<V1_0::CpuUsage>*)>;
+    using CpuIdleReader =
+            std::function<bool(std::vector<CpuIdleTotal>*, std::vector<float>* busy)>;
+
+    explicit ThermalMetrics(ThermalSnapshot& snapshot);
+
+    static const char *callName(Call call);
+
+    // Lock-free; called on every HIDL entry point.
+    void recordCall(Call call, int64_t durationNs);
+
+    // Takes over a bound stream socket and starts the thread.
+    bool startServing(int socketFd, const CpuReader& cpuReader,
+                      const CpuIdleReader& cpuIdleReader);
+
+    std::string render();
+
+  private:
+    static constexpr size_t kNumBuckets = 10;
+
+    bool threadLoop() override;
+
+    ThermalSnapshot& mSnapshot;
+    CpuReader mCpuReader;
+    CpuIdleReader mCpuIdleReader;
+    ::android::base::unique_fd mSocket;
+    // Bucket i counts calls no longer than the bound of bucket i and longer
+    // than the previous one; the last bucket has no bound.
+    std::array<std::array<std::atomic<uint64_t>, kNumBuckets>, kNumCalls> mBuckets{};
+    std::array<std::atomic<int64_t>, kNumCalls> mSumNs{};
+};
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
+
+#endif  // ANDROID_HARDWARE_THERMAL_V1_1_THERMALMETRICS_H
@@ -0,0 +1,421 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "ThermalHAL"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <math.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include <android-base/file.h>
+#include <android-base/unique_fd.h>
+#include <log/log.h>
+
+#include "ThermalSnapshot.h"
+
+#define SNAPSHOT_MAGIC          0x52544853  // "SHTR"
+#define SNAPSHOT_VERSION        3
+#define BOOT_ID_FILE            "/proc/sys/kernel/random/boot_id"
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+static const char *kBandNames[kNumTemperatureBands] = {
+    "<30", "30-40", "40-50", "50-60", "60-70", "70-80",
+    "80-90", "90-100", "100-110", "110-120", ">=120",
+};
+
+static size_t snapshotSize(size_t zoneCount) {
+    return sizeof(ThermalSnapshot::Header) + zoneCount * sizeof(ThermalSnapshot::Zone) +
+           kMaxSnapshotActuators * sizeof(ThermalSnapshot::Actuator);
+}
+
+static void copyName(char *dst, const std::string& src) {
+    strncpy(dst, src.c_str(), kSnapshotNameLength - 1);
+    dst[kSnapshotNameLength - 1] = '\0';
+}
+
+static void copyBootId(char *dst, const std::string& src) {
+    strncpy(dst, src.c_str(), kSnapshotBootIdLength - 1);
+    dst[kSnapshotBootIdLength - 1] = '\0';
+    dst[strcspn(dst, "\n")] = '\0';
+}
+
+ThermalSnapshot::~ThermalSnapshot() {
+    if (mMap != nullptr) {
+        munmap(mMap, mMapSize);
+    }
+}
+
+size_t ThermalSnapshot::temperatureBand(float temperature) {
+    if (isnan(temperature)) {
+        return kNoTemperatureBand;
+    }
+    if (temperature < kSnapshotBandBase) {
+        return 0;
+    }
+    return std::min<size_t>(1 + (temperature - kSnapshotBandBase) / kSnapshotBandStep,
+                            kNumTemperatureBands - 1);
+}
+
+const char *ThermalSnapshot::bandName(size_t band) {
+    return band < kNumTemperatureBands ? kBandNames[band] : "?";
+}
+
+ThermalSnapshot::Zone *ThermalSnapshot::zones() const {
+    return reinterpret_cast<Zone *>(mHeader + 1);
+}
+
+ThermalSnapshot::Actuator *ThermalSnapshot::actuators() const {
+    return reinterpret_cast<Actuator *>(zones() + mHeader->zoneCount);
+}
+
+bool ThermalSnapshot::open(const std::string& path, const std::vector<std::string>& zoneNames) {
+    std::lock_guard<std::mutex> _lock(mLock);
+    // Re-opening after zones were added keeps the live counters.
+    mPrevious.clear();
+    if (mMap != nullptr) {
+        mPrevious.assign(static_cast<const char *>(mMap), mMapSize);
+        munmap(mMap, mMapSize);
+        mMap = nullptr;
+        mHeader = nullptr;
+    }
+    mMapSize = snapshotSize(zoneNames.size());
+    mZoneReadNs.resize(zoneNames.size(), 0);
+
+    // The new layout is built in a file of its own and renamed over the old
+    // one, so a crash while reopening never leaves a truncated snapshot.
+    if (mPrevious.empty() && !::android::base::ReadFileToString(path, &mPrevious)) {
+        mPrevious.clear();
+    }
+    const std::string tmpPath = path + ".tmp";
+    ::android::base::unique_fd fd(TEMP_FAILURE_RETRY(
+            ::open(tmpPath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0660)));
+    if (fd < 0 || ftruncate(fd, mMapSize) != 0) {
+        ALOGE("%s: failed to create %s: %s", __func__, tmpPath.c_str(), strerror(errno));
+        fd.reset();
+    }
+
+    mMap = mmap(nullptr, mMapSize, PROT_READ | PROT_WRITE,
+                fd >= 0 ? MAP_SHARED : MAP_PRIVATE | MAP_ANONYMOUS, fd, 0);
+    if (mMap == MAP_FAILED) {
+        ALOGE("%s: failed to map snapshot: %s", __func__, strerror(errno));
+        mMap = nullptr;
+        return false;
+    }
+
+    mHeader = static_cast<Header *>(mMap);
+    memset(mMap, 0, mMapSize);
+    mHeader->magic = SNAPSHOT_MAGIC;
+    mHeader->version = SNAPSHOT_VERSION;
+    mHeader->zoneCount = zoneNames.size();
+    std::string bootId;
+    if (::android::base::ReadFileToString(BOOT_ID_FILE, &bootId)) {
+        copyBootId(mHeader->bootId, bootId);
+    }
+    mHeader->gpu.utilization = NAN;
+    for (size_t z = 0; z < zoneNames.size(); ++z) {
+        copyName(zones()[z].name, zoneNames[z]);
+        zones()[z].temperature = NAN;
+    }
+
+    // Carry the counters of the previous run over.
+    const Header *prev = reinterpret_cast<const Header *>(mPrevious.data());
+    if (mPrevious.size() < sizeof(Header) || prev->magic != SNAPSHOT_MAGIC ||
+        prev->version != SNAPSHOT_VERSION ||
+        mPrevious.size() != snapshotSize(prev->zoneCount)) {
+        mPrevious.clear();
+        return fd >= 0 && commit(fd, tmpPath, path);
+    }
+    mHeader->totalNs = prev->totalNs;
+    memcpy(mHeader->deviceBandNs, prev->deviceBandNs, sizeof(prev->deviceBandNs));
+    memcpy(mHeader->deviceLevelNs, prev->deviceLevelNs, sizeof(prev->deviceLevelNs));
+    mHeader->gpu.busyNs = prev->gpu.busyNs;
+    mHeader->gpu.totalNs = prev->gpu.totalNs;
+    if (mLastNs != 0) {
+        mHeader->gpu = prev->gpu;
+    }
+    const Zone *prevZones = reinterpret_cast<const Zone *>(prev + 1);
+    const Actuator *prevActuators =
+            reinterpret_cast<const Actuator *>(prevZones + prev->zoneCount);
+    // A restart within the same boot resumes the levels the previous process
+    // left so that clients are not told about the same transition twice.
+    const bool sameBoot = mHeader->bootId[0] != '\0' &&
+            !strncmp(mHeader->bootId, prev->bootId, kSnapshotBootIdLength);
+    if (mLastNs != 0 || sameBoot) {
+        mHeader->deviceLevel = prev->deviceLevel;
+    }
+    if (mLastNs != 0) {
+        // Same process: actuators stay registered under their index.
+        mHeader->actuatorCount = prev->actuatorCount;
+        memcpy(actuators(), prevActuators, prev->actuatorCount * sizeof(Actuator));
+    }
+    for (size_t z = 0; z < zoneNames.size(); ++z) {
+        // Within one process zone indices are stable; across restarts zones
+        // are matched by name.
+        const Zone *match = nullptr;
+        if (mLastNs != 0) {
+            match = z < prev->zoneCount ? &prevZones[z] : nullptr;
+        } else {
+            for (size_t p = 0; p < prev->zoneCount && match == nullptr; ++p) {
+                if (!strncmp(zones()[z].name, prevZones[p].name, kSnapshotNameLength)) {
+                    match = &prevZones[p];
+                }
+            }
+        }
+        if (match == nullptr) {
+            continue;
+        }
+        memcpy(zones()[z].bandNs, match->bandNs, sizeof(match->bandNs));
+        memcpy(zones()[z].levelNs, match->levelNs, sizeof(match->levelNs));
+        if (mLastNs != 0 || sameBoot) {
+            zones()[z].temperature = match->temperature;
+            zones()[z].level = match->level;
+            zones()[z].band = match->band;
+        }
+    }
+    return fd >= 0 && commit(fd, tmpPath, path);
+}
+
+bool ThermalSnapshot::commit(int fd, const std::string& tmpPath, const std::string& path) {
+    if (msync(mMap, mMapSize, MS_SYNC) != 0 || fsync(fd) != 0 ||
+        rename(tmpPath.c_str(), path.c_str()) != 0) {
+        ALOGE("%s: failed to replace %s: %s", __func__, path.c_str(), strerror(errno));
+        unlink(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+SeverityLevel ThermalSnapshot::level(size_t zone) {
+    std::lock_guard<std::mutex> _lock(mLock);
+    if (mHeader == nullptr || zone >= mHeader->zoneCount) {
+        return SeverityLevel::NONE;
+    }
+    return static_cast<SeverityLevel>(zones()[zone].level);
+}
+
+float ThermalSnapshot::temperature(size_t zone) {
+    std::lock_guard<std::mutex> _lock(mLock);
+    if (mHeader == nullptr || zone >= mHeader->zoneCount) {
+        return NAN;
+    }
+    return zones()[zone].temperature;
+}
+
+void ThermalSnapshot::update(const float *temperatures, const int64_t *readNs,
+                             const uint8_t *levels, SeverityLevel deviceLevel, int64_t nowNs) {
+    std::lock_guard<std::mutex> _lock(mLock);
+    if (mHeader == nullptr) {
+        return;
+    }
+
+    // A zone is charged from one of its readings to the next, so zones
+    // polled slower than the evaluations, and zones without a reading, are
+    // charged for the time they were actually seen in a band.
+    float maxTemperature = NAN;
+    Zone *z = zones();
+    for (size_t i = 0; i < mHeader->zoneCount; ++i) {
+        if (!isnan(temperatures[i])) {
+            maxTemperature = fmaxf(maxTemperature, temperatures[i]);
+        }
+        if (readNs[i] == mZoneReadNs[i]) {
+            continue;
+        }
+        if (mZoneReadNs[i] != 0 && z[i].band != kNoTemperatureBand) {
+            const int64_t elapsed = readNs[i] - mZoneReadNs[i];
+            z[i].bandNs[z[i].band] += elapsed;
+            z[i].levelNs[z[i].level] += elapsed;
+        }
+        mZoneReadNs[i] = readNs[i];
+        z[i].temperature = temperatures[i];
+        z[i].band = temperatureBand(temperatures[i]);
+        z[i].level = levels[i];
+    }
+
+    const int64_t elapsed = mLastNs != 0 ? nowNs - mLastNs : 0;
+    mLastNs = nowNs;
+    if (mDeviceBand != kNoTemperatureBand) {
+        mHeader->deviceBandNs[mDeviceBand] += elapsed;
+    }
+    mDeviceBand = temperatureBand(maxTemperature);
+    mHeader->deviceLevelNs[mHeader->deviceLevel] += elapsed;
+    mHeader->deviceLevel = static_cast<uint8_t>(deviceLevel);
+    mHeader->totalNs += elapsed;
+    mHeader->updatedNs = nowNs;
+}
+
+int ThermalSnapshot::addActuator(const std::string& name) {
+    std::lock_guard<std::mutex> _lock(mLock);
+    if (mHeader == nullptr || mHeader->actuatorCount >= kMaxSnapshotActuators) {
+        return -1;
+    }
+
+    const int index = mHeader->actuatorCount++;
+    Actuator& actuator = actuators()[index];
+    copyName(actuator.name, name);
+    if (!mPrevious.empty()) {
+        const Header *prev = reinterpret_cast<const Header *>(mPrevious.data());
+        const Actuator *prevActuators = reinterpret_cast<const Actuator *>(
+                reinterpret_cast<const Zone *>(prev + 1) + prev->zoneCount);
+        for (size_t a = 0; a < prev->actuatorCount; ++a) {
+            if (!strncmp(actuator.name, prevActuators[a].name, kSnapshotNameLength)) {
+                memcpy(actuator.stateNs, prevActuators[a].stateNs, sizeof(actuator.stateNs));
+                break;
+            }
+        }
+    }
+    return index;
+}
+
+void ThermalSnapshot::updateActuator(int index, uint32_t state, int64_t nowNs) {
+    std::lock_guard<std::mutex> _lock(mLock);
+    if (mHeader == nullptr || index < 0 || index >= static_cast<int>(mHeader->actuatorCount)) {
+        return;
+    }
+
+    Actuator& actuator = actuators()[index];
+    if (mActuatorLastNs[index] != 0) {
+        actuator.stateNs[actuator.state] += nowNs - mActuatorLastNs[index];
+    }
+    mActuatorLastNs[index] = nowNs;
+    actuator.state = std::min<uint32_t>(state, kMaxActuatorStates - 1);
+}
+
+size_t ThermalSnapshot::actuatorStates(uint8_t *states, size_t max) {
+    std::lock_guard<std::mutex> _lock(mLock);
+    if (mHeader == nullptr) {
+        return 0;
+    }
+
+    const size_t count = std::min<size_t>(mHeader->actuatorCount, max);
+    for (size_t a = 0; a < count; ++a) {
+        states[a] = actuators()[a].state;
+    }
+    return count;
+}
+
+std::vector<std::string> ThermalSnapshot::actuatorNames() {
+    std::lock_guard<std::mutex> _lock(mLock);
+    std::vector<std::string> names;
+    for (size_t a = 0; mHeader != nullptr && a < mHeader->actuatorCount; ++a) {
+        names.push_back(actuators()[a].name);
+    }
+    return names;
+}
+
+void ThermalSnapshot::updateGpu(uint64_t freqHz, uint32_t coolingState, bool hasLoad,
+                                int64_t busyNs, int64_t elapsedNs) {
+    std::lock_guard<std::mutex> _lock(mLock);
+    if (mHeader == nullptr || elapsedNs <= 0) {
+        return;
+    }
+
+    Gpu& gpu = mHeader->gpu;
+    gpu.freqHz = freqHz;
+    gpu.coolingState = coolingState;
+    gpu.utilization = hasLoad ? static_cast<float>(busyNs) / elapsedNs : NAN;
+    if (hasLoad) {
+        gpu.busyNs += busyNs;
+        gpu.totalNs += elapsedNs;
+    }
+}
+
+bool ThermalSnapshot::copy(std::string* out) {
+    std::lock_guard<std::mutex> _lock(mLock);
+    if (mHeader == nullptr) {
+        return false;
+    }
+    out->assign(static_cast<const char *>(mMap), mMapSize);
+    return true;
+}
+
+void ThermalSnapshot::dump(int fd) {
+    // Formatted from a copy so that the watcher never waits on the reader.
+    std::string copied;
+    if (!copy(&copied)) {
+        return;
+    }
+    const Header *header = reinterpret_cast<const Header *>(copied.data());
+    const Zone *zones = reinterpret_cast<const Zone *>(header + 1);
+    const Actuator *actuators = reinterpret_cast<const Actuator *>(zones + header->zoneCount);
+
+    const double total = header->totalNs > 0 ? header->totalNs : 1;
+    dprintf(fd, "ThermalSnapshot:\n");
+    dprintf(fd, "  accounted: %.1f h\n", header->totalNs / 3600e9);
+    dprintf(fd, "  device band residency:");
+    for (size_t b = 0; b < kNumTemperatureBands; ++b) {
+        dprintf(fd, " %s=%.1f%%", kBandNames[b], 100 * header->deviceBandNs[b] / total);
+    }
+    dprintf(fd, "\n  device level residency:");
+    for (size_t l = 0; l < kNumSeverityLevels; ++l) {
+        dprintf(fd, " %s=%.1f%%", toString(static_cast<SeverityLevel>(l)),
+                100 * header->deviceLevelNs[l] / total);
+    }
+    dprintf(fd, "\n");
+
+    for (size_t i = 0; i < header->zoneCount; ++i) {
+        const Zone& z = zones[i];
+        dprintf(fd, "  %s: %.1f C, %s\n    bands:", z.name, z.temperature,
+                toString(static_cast<SeverityLevel>(z.level)));
+        for (size_t b = 0; b < kNumTemperatureBands; ++b) {
+            if (z.bandNs[b] != 0) {
+                dprintf(fd, " %s=%.1f%%", kBandNames[b], 100 * z.bandNs[b] / total);
+            }
+        }
+        dprintf(fd, "\n    levels:");
+        for (size_t l = 0; l < kNumSeverityLevels; ++l) {
+            if (z.levelNs[l] != 0) {
+                dprintf(fd, " %s=%.1f%%", toString(static_cast<SeverityLevel>(l)),
+                        100 * z.levelNs[l] / total);
+            }
+        }
+        dprintf(fd, "\n");
+    }
+
+    for (size_t a = 0; a < header->actuatorCount; ++a) {
+        const Actuator& actuator = actuators[a];
+        dprintf(fd, "  actuator %s: state %u\n    caps:", actuator.name, actuator.state);
+        for (size_t s = 0; s < kMaxActuatorStates; ++s) {
+            if (actuator.stateNs[s] != 0) {
+                dprintf(fd, " %zu=%" PRId64 "ms", s, actuator.stateNs[s] / 1000000);
+            }
+        }
+        dprintf(fd, "\n");
+    }
+
+    const Gpu& gpu = header->gpu;
+    if (gpu.freqHz != 0) {
+        dprintf(fd, "  gpu: %" PRIu64 " MHz, cooling state %u, busy %.1f%%, %.1f%% over %.1f h\n",
+                gpu.freqHz / 1000000, gpu.coolingState, 100 * gpu.utilization,
+                gpu.totalNs > 0 ? 100. * gpu.busyNs / gpu.totalNs : 0., gpu.totalNs / 3600e9);
+    }
+}
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ANDROID_HARDWARE_THERMAL_V1_1_THERMALSNAPSHOT_H
+#define ANDROID_HARDWARE_THERMAL_V1_1_THERMALSNAPSHOT_H
+
+#include <stdint.h>
+
+#include <array>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "SeverityEngine.h"
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+// Temperature bands are kSnapshotBandStep degrees wide starting at
+// kSnapshotBandBase, with one open band below and one above. A zone without
+// a reading is in no band.
+constexpr int kSnapshotBandBase = 30;
+constexpr int kSnapshotBandStep = 10;
+constexpr size_t kNumTemperatureBands = 11;
+constexpr uint8_t kNoTemperatureBand = UINT8_MAX;
+constexpr size_t kMaxSnapshotActuators = 8;
+constexpr size_t kMaxActuatorStates = 16;
+constexpr size_t kSnapshotNameLength = 24;
+constexpr size_t kSnapshotBootIdLength = 40;
+
+// The latest sample and cumulative residency counters, kept in a file that
+// is mapped shared so every update is a plain memory store and the counters
+// survive service restarts.
+class ThermalSnapshot {
+  public:
+    struct Gpu {
+        uint64_t freqHz;
+        uint32_t coolingState;
+        // Estimated busy share of the last window, NAN if the GPU reports
+        // no load.
+        float utilization;
+        // Cumulative, like CPU time in /proc/stat.
+        int64_t busyNs;
+        int64_t totalNs;
+    };
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t zoneCount;
+        uint32_t actuatorCount;
+        int64_t updatedNs;
+        int64_t totalNs;
+        uint8_t deviceLevel;
+        uint8_t reserved[7];
+        // Levels are only meaningful to a process started in the same boot.
+        char bootId[kSnapshotBootIdLength];
+        int64_t deviceBandNs[kNumTemperatureBands];
+        int64_t deviceLevelNs[kNumSeverityLevels];
+        Gpu gpu;
+    };
+
+    struct Zone {
+        char name[kSnapshotNameLength];
+        float temperature;
+        uint8_t level;
+        uint8_t band;
+        uint8_t reserved[2];
+        int64_t bandNs[kNumTemperatureBands];
+        int64_t levelNs[kNumSeverityLevels];
+    };
+
+    struct Actuator {
+        char name[kSnapshotNameLength];
+        uint32_t state;
+        uint32_t reserved;
+        int64_t stateNs[kMaxActuatorStates];
+    };
+
+    ThermalSnapshot() = default;
+    ~ThermalSnapshot();
+    ThermalSnapshot(const ThermalSnapshot&) = delete;
+    ThermalSnapshot& operator=(const ThermalSnapshot&) = delete;
+
+    // Lays out one record per zone, keeping the counters of zones and
+    // actuators with the same name from a previous run, and their last
+    // levels if that run was in the same boot. Falls back to an anonymous
+    // mapping when path cannot be used. The file is rebuilt next to path and
+    // renamed over it.
+    bool open(const std::string& path, const std::vector<std::string>& zoneNames);
+    // Last recorded level and temperature of a zone.
+    SeverityLevel level(size_t zone);
+    float temperature(size_t zone);
+
+    // Records the new sample. Zones whose readNs moved since the previous
+    // call are charged the time between their two readings in the band and
+    // level of the earlier one; the device is charged the time between calls.
+    // NAN temperatures are in no band. O(1) per zone.
+    void update(const float *temperatures, const int64_t *readNs, const uint8_t *levels,
+                SeverityLevel deviceLevel, int64_t nowNs);
+
+    // Returns the actuator index, or -1 once kMaxSnapshotActuators are in use.
+    int addActuator(const std::string& name);
+    void updateActuator(int actuator, uint32_t state, int64_t nowNs);
+    // Copies the current actuator states and returns how many there are.
+    size_t actuatorStates(uint8_t *states, size_t max);
+    std::vector<std::string> actuatorNames();
+
+    // Adds a window of GPU activity; hasLoad is false if busyNs is unknown.
+    void updateGpu(uint64_t freqHz, uint32_t coolingState, bool hasLoad, int64_t busyNs,
+                   int64_t elapsedNs);
+
+    void dump(int fd);
+    // Copies the whole mapping, Header first, for readers on other threads.
+    bool copy(std::string* out);
+
+    static size_t temperatureBand(float temperature);
+    static const char *bandName(size_t band);
+
+  private:
+    Zone *zones() const;
+    Actuator *actuators() const;
+    // Makes the mapping of tmpPath durable and moves it to path.
+    bool commit(int fd, const std::string& tmpPath, const std::string& path);
+
+    std::mutex mLock;
+    void *mMap = nullptr;
+    size_t mMapSize = 0;
+    std::string mPrevious;
+    int64_t mLastNs = 0;
+    // Reading of every zone last accounted, and the band of the device.
+    std::vector<int64_t> mZoneReadNs;
+    size_t mDeviceBand = kNoTemperatureBand;
+    std::array<int64_t, kMaxSnapshotActuators> mActuatorLastNs{};
+    Header *mHeader = nullptr;
+};
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
+
+#endif  // ANDROID_HARDWARE_THERMAL_V1_1_THERMALSNAPSHOT_H
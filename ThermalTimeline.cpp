@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "ThermalHAL"
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include <android-base/file.h>
+#include <android-base/stringprintf.h>
+#include <android-base/strings.h>
+
+#include "ThermalTimeline.h"
+
+#define TIMELINE_FLUSH_SIZE     65536
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+using ::android::base::StringAppendF;
+
+static const char *kTrackNames[ThermalTimeline::kNumTracks] = {
+    "temperature", "level", "cap",
+};
+
+namespace {
+
+// Buffer of the calling thread, looked up once per thread.
+struct ThreadSlot {
+    uint64_t owner = 0;
+    void *buffer = nullptr;
+};
+thread_local ThreadSlot tSlot;
+std::atomic<uint64_t> sNextId{1};
+
+}  // namespace
+
+// Zone and thread names come from the kernel and the configuration, so
+// they may hold anything JSON gives a meaning to.
+static std::string escapeJson(const std::string& text) {
+    std::string out;
+    out.reserve(text.size());
+    for (const char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            StringAppendF(&out, "\\u%04x", c);
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+static void appendEvent(std::string* out, const ThermalTimeline::Event& event, pid_t pid,
+                        pid_t tid, const std::vector<std::string>& zoneNames,
+                        const std::vector<std::string>& actuatorNames) {
+    if (event.name != nullptr) {
+        StringAppendF(out, ",\n{\"name\":\"%s\",\"cat\":\"thermal\",\"ph\":\"X\","
+                      "\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%d",
+                      escapeJson(event.name).c_str(), event.startNs / 1e3,
+                      (event.endNs - event.startNs) / 1e3, pid, tid);
+        if (event.index >= 0) {
+            StringAppendF(out, ",\"args\":{\"index\":%d}", event.index);
+        }
+        *out += "}";
+        return;
+    }
+    // JSON has no NaN; an unread zone leaves a gap in its track.
+    if (isnan(event.value) || event.track >= ThermalTimeline::kNumTracks) {
+        return;
+    }
+    const auto& names = event.track == ThermalTimeline::CAP ? actuatorNames : zoneNames;
+    const std::string name = static_cast<size_t>(event.index) < names.size()
+            ? escapeJson(names[event.index])
+            : ::android::base::StringPrintf("#%d", event.index);
+    StringAppendF(out, ",\n{\"name\":\"%s %s\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":%d,"
+                  "\"args\":{\"value\":%g}}", name.c_str(), kTrackNames[event.track],
+                  event.startNs / 1e3, pid, event.value);
+}
+
+ThermalTimeline::ThermalTimeline() : mId(sNextId.fetch_add(1, std::memory_order_relaxed)) {}
+
+ThermalTimeline::ThreadBuffer *ThermalTimeline::threadBuffer() {
+    if (tSlot.owner == mId) {
+        return static_cast<ThreadBuffer *>(tSlot.buffer);
+    }
+
+    std::lock_guard<std::mutex> _lock(mLock);
+    mBuffers.push_back(std::make_unique<ThreadBuffer>());
+    mBuffers.back()->tid = gettid();
+    tSlot.owner = mId;
+    tSlot.buffer = mBuffers.back().get();
+    return mBuffers.back().get();
+}
+
+void ThermalTimeline::append(const Event& event) {
+    ThreadBuffer *buffer = threadBuffer();
+    const uint64_t head = buffer->head.load(std::memory_order_relaxed);
+    buffer->events[head % kTimelineThreadEvents] = event;
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+void ThermalTimeline::slice(const char *name, int64_t startNs, int64_t endNs, int32_t index) {
+    append({startNs, endNs, name, 0, index, 0});
+}
+
+void ThermalTimeline::counter(Track track, size_t index, double value, int64_t nowNs) {
+    append({nowNs, nowNs, nullptr, value, static_cast<int32_t>(index), track});
+}
+
+void ThermalTimeline::writeJson(int fd, const std::vector<std::string>& zoneNames,
+                                const std::vector<std::string>& actuatorNames) {
+    std::vector<ThreadBuffer *> buffers;
+    {
+        std::lock_guard<std::mutex> _lock(mLock);
+        for (const auto& buffer : mBuffers) {
+            buffers.push_back(buffer.get());
+        }
+    }
+
+    const pid_t pid = getpid();
+    std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    StringAppendF(&out, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,"
+                  "\"args\":{\"name\":\"thermal HAL\"}}", pid);
+    std::vector<Event> events;
+    for (ThreadBuffer *buffer : buffers) {
+        // The owner keeps writing while the ring is copied: anything it may
+        // have overwritten in the meantime is dropped.
+        const uint64_t head = buffer->head.load(std::memory_order_acquire);
+        const uint64_t first = head > kTimelineThreadEvents ? head - kTimelineThreadEvents : 0;
+        events.clear();
+        for (uint64_t i = first; i < head; ++i) {
+            events.push_back(buffer->events[i % kTimelineThreadEvents]);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t after = buffer->head.load(std::memory_order_relaxed);
+        const uint64_t valid = after > kTimelineThreadEvents ? after - kTimelineThreadEvents : 0;
+        const size_t skip = valid > first ? std::min<uint64_t>(valid - first, events.size()) : 0;
+
+        std::string comm;
+        if (::android::base::ReadFileToString(
+                    ::android::base::StringPrintf("/proc/self/task/%d/comm", buffer->tid),
+                    &comm)) {
+            StringAppendF(&out, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,"
+                          "\"tid\":%d,\"args\":{\"name\":\"%s\"}}", pid, buffer->tid,
+                          escapeJson(::android::base::Trim(comm)).c_str());
+        }
+        for (size_t i = skip; i < events.size(); ++i) {
+            appendEvent(&out, events[i], pid, buffer->tid, zoneNames, actuatorNames);
+            if (out.size() >= TIMELINE_FLUSH_SIZE) {
+                ::android::base::WriteFully(fd, out.data(), out.size());
+                out.clear();
+            }
+        }
+    }
+    out += "\n]}\n";
+    ::android::base::WriteFully(fd, out.data(), out.size());
+}
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
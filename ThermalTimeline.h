@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ANDROID_HARDWARE_THERMAL_V1_1_THERMALTIMELINE_H
+#define ANDROID_HARDWARE_THERMAL_V1_1_THERMALTIMELINE_H
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+constexpr size_t kTimelineThreadEvents = 4096;
+
+// Slices and counters in boot clock time, kept in one ring per thread so
+// that recording takes no lock and never blocks. Every thread keeps its
+// last kTimelineThreadEvents events. writeJson() writes them in the Chrome
+// trace event format, which the Perfetto UI and chrome://tracing open next
+// to system traces.
+//
+// Callers check enabled() before doing any work for an event, so a
+// disabled timeline costs one well-predicted branch.
+class ThermalTimeline {
+  public:
+    enum Track : uint8_t {
+        // Degrees Celsius of a zone.
+        TEMPERATURE,
+        // SeverityLevel of a zone.
+        LEVEL,
+        // State of a cooling device.
+        CAP,
+        kNumTracks,
+    };
+
+    ThermalTimeline();
+    ThermalTimeline(const ThermalTimeline&) = delete;
+    ThermalTimeline& operator=(const ThermalTimeline&) = delete;
+
+    bool enabled() const { return mEnabled.load(std::memory_order_relaxed); }
+    void setEnabled(bool enabled) { mEnabled.store(enabled, std::memory_order_relaxed); }
+
+    // name must outlive the timeline, e.g. a string literal. index is shown
+    // as an argument when not negative.
+    void slice(const char *name, int64_t startNs, int64_t endNs, int32_t index = -1);
+    void counter(Track track, size_t index, double value, int64_t nowNs);
+
+    // Names are indexed like the zone and actuator indices recorded.
+    void writeJson(int fd, const std::vector<std::string>& zoneNames,
+                   const std::vector<std::string>& actuatorNames);
+
+    // One slice, or one counter value when name is null.
+    struct Event {
+        int64_t startNs;
+        int64_t endNs;
+        const char *name;
+        double value;
+        int32_t index;
+        uint8_t track;
+    };
+
+  private:
+    // Written only by its thread; head counts every event ever written.
+    struct ThreadBuffer {
+        pid_t tid;
+        std::atomic<uint64_t> head{0};
+        std::array<Event, kTimelineThreadEvents> events;
+    };
+
+    ThreadBuffer *threadBuffer();
+    void append(const Event& event);
+
+    // Unique to the instance, unlike its address, which a timeline created
+    // after this one is destroyed may reuse while threads still cache it.
+    const uint64_t mId;
+    std::atomic<bool> mEnabled{false};
+    std::mutex mLock;
+    std::vector<std::unique_ptr<ThreadBuffer>> mBuffers;
+};
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
+
+#endif  // ANDROID_HARDWARE_THERMAL_V1_1_THERMALTIMELINE_H
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "ThermalHAL"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <android-base/file.h>
+#include <log/log.h>
+
+#include "ThermalTrace.h"
+
+#define TRACE_MAGIC             0x54544853  // "SHTT"
+#define TRACE_VERSION           2
+#define TRACE_FLUSH_SIZE        4096
+#define TRACE_MAX_NAME_LENGTH   256
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+static size_t paddedLength(size_t length) {
+    return (length + 7) & ~static_cast<size_t>(7);
+}
+
+bool ThermalTraceWriter::open(const std::string& path) {
+    std::lock_guard<std::mutex> _lock(mLock);
+    mFd.reset(TEMP_FAILURE_RETRY(
+            ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0660)));
+    const ThermalTrace::Header header = {TRACE_MAGIC, TRACE_VERSION};
+    if (mFd < 0 || !::android::base::WriteFully(mFd, &header, sizeof(header))) {
+        ALOGE("%s: failed to open %s: %s", __func__, path.c_str(), strerror(errno));
+        mFd.reset();
+        return false;
+    }
+    mBuffer.reserve(TRACE_FLUSH_SIZE * 2);
+    return true;
+}
+
+bool ThermalTraceWriter::isOpen() const {
+    std::lock_guard<std::mutex> _lock(mLock);
+    return mFd >= 0;
+}
+
+void ThermalTraceWriter::zoneAdded(int64_t nowNs, size_t zone, const std::string& name) {
+    append({nowNs, 0, ThermalTrace::ZONE_ADDED, static_cast<uint16_t>(zone),
+            static_cast<uint32_t>(name.size())}, name);
+}
+
+void ThermalTraceWriter::zoneRead(int64_t nowNs, size_t zone, int32_t milliCelsius) {
+    append({nowNs, milliCelsius, ThermalTrace::ZONE_READ, static_cast<uint16_t>(zone), 0}, "");
+}
+
+void ThermalTraceWriter::cpuRead(int64_t nowNs, size_t cpu, uint64_t active, uint64_t total) {
+    append({nowNs, static_cast<int64_t>(active), ThermalTrace::CPU_READ,
+            static_cast<uint16_t>(cpu), static_cast<uint32_t>(total - active)}, "");
+}
+
+void ThermalTraceWriter::actuatorAdded(int64_t nowNs, size_t actuator, const std::string& name) {
+    append({nowNs, 0, ThermalTrace::ACTUATOR_ADDED, static_cast<uint16_t>(actuator),
+            static_cast<uint32_t>(name.size())}, name);
+}
+
+void ThermalTraceWriter::actuatorRead(int64_t nowNs, size_t actuator, uint32_t state) {
+    append({nowNs, state, ThermalTrace::ACTUATOR_READ, static_cast<uint16_t>(actuator), 0}, "");
+}
+
+void ThermalTraceWriter::append(const ThermalTrace::Record& record, const std::string& name) {
+    std::lock_guard<std::mutex> _lock(mLock);
+    if (mFd < 0) {
+        return;
+    }
+
+    const char *bytes = reinterpret_cast<const char *>(&record);
+    mBuffer.insert(mBuffer.end(), bytes, bytes + sizeof(record));
+    mBuffer.insert(mBuffer.end(), name.begin(), name.end());
+    mBuffer.resize(mBuffer.size() + paddedLength(name.size()) - name.size(), '\0');
+    if (mBuffer.size() >= TRACE_FLUSH_SIZE) {
+        writeLocked();
+    }
+}
+
+void ThermalTraceWriter::flush() {
+    std::lock_guard<std::mutex> _lock(mLock);
+    if (mFd >= 0 && !mBuffer.empty()) {
+        writeLocked();
+    }
+}
+
+void ThermalTraceWriter::writeLocked() {
+    if (!::android::base::WriteFully(mFd, mBuffer.data(), mBuffer.size())) {
+        ALOGE("%s: failed to write trace, recording stopped: %s", __func__, strerror(errno));
+        mFd.reset();
+    }
+    mBuffer.clear();
+}
+
+bool ThermalTraceReader::open(const std::string& path) {
+    mFd.reset(TEMP_FAILURE_RETRY(::open(path.c_str(), O_RDONLY | O_CLOEXEC)));
+    ThermalTrace::Header header;
+    if (mFd < 0 || !::android::base::ReadFully(mFd, &header, sizeof(header)) ||
+        header.magic != TRACE_MAGIC || header.version != TRACE_VERSION) {
+        ALOGE("%s: %s is not a thermal trace", __func__, path.c_str());
+        mFd.reset();
+        return false;
+    }
+    return true;
+}
+
+bool ThermalTraceReader::next(ThermalTrace::Event* event) {
+    ThermalTrace::Record record;
+    if (mFd < 0 || !::android::base::ReadFully(mFd, &record, sizeof(record))) {
+        return false;
+    }
+
+    event->bootNs = record.bootNs;
+    event->kind = static_cast<ThermalTrace::Kind>(record.kind);
+    event->index = record.index;
+    event->value = record.value;
+    event->total = 0;
+    event->name.clear();
+    if (record.kind == ThermalTrace::ZONE_ADDED || record.kind == ThermalTrace::ACTUATOR_ADDED) {
+        char name[TRACE_MAX_NAME_LENGTH + 8];
+        if (record.extra > TRACE_MAX_NAME_LENGTH ||
+            !::android::base::ReadFully(mFd, name, paddedLength(record.extra))) {
+            return false;
+        }
+        event->name.assign(name, record.extra);
+    } else if (record.kind == ThermalTrace::CPU_READ) {
+        if (record.index >= mCpuIdle.size()) {
+            mCpuIdle.resize(record.index + 1, 0);
+        }
+        // Idle time only grows, so the low bits moving forward tell how
+        // far it went.
+        uint64_t& idle = mCpuIdle[record.index];
+        idle += static_cast<uint32_t>(record.extra - static_cast<uint32_t>(idle));
+        event->total = record.value + idle;
+    }
+    return true;
+}
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ANDROID_HARDWARE_THERMAL_V1_1_THERMALTRACE_H
+#define ANDROID_HARDWARE_THERMAL_V1_1_THERMALTRACE_H
+
+#include <stdint.h>
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <android-base/unique_fd.h>
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+// Raw sensor reads as they were made, in boot clock order. A trace starts
+// with a Header and continues with 24-byte Records; an *_ADDED record is
+// followed by the name padded to a multiple of eight bytes.
+struct ThermalTrace {
+    enum Kind : uint16_t {
+        // extra: length of the zone name.
+        ZONE_ADDED = 1,
+        // value: milli-degrees Celsius.
+        ZONE_READ,
+        // value: active jiffies, extra: idle jiffies modulo 2^32.
+        CPU_READ,
+        // extra: length of the cooling device name.
+        ACTUATOR_ADDED,
+        // value: cur_state of the cooling device.
+        ACTUATOR_READ,
+    };
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+    };
+
+    struct Record {
+        int64_t bootNs;
+        int64_t value;
+        uint16_t kind;
+        uint16_t index;
+        uint32_t extra;
+    };
+    static_assert(sizeof(Record) == 24, "trace records are 24 bytes");
+
+    struct Event {
+        int64_t bootNs;
+        Kind kind;
+        size_t index;
+        int64_t value;
+        // CPU_READ: active plus idle jiffies. Idle jiffies are only recorded
+        // modulo 2^32, so the total is off by a multiple of 2^32 that is
+        // the same for every read of a CPU, and the difference between two
+        // reads is exact.
+        int64_t total;
+        std::string name;
+    };
+};
+
+// Appends to a trace from any thread. Records are buffered and written with
+// one write() per flush().
+class ThermalTraceWriter {
+  public:
+    // Truncates path and writes a new header.
+    bool open(const std::string& path);
+    // False once a write failed; callers can skip preparing records then.
+    bool isOpen() const;
+
+    void zoneAdded(int64_t nowNs, size_t zone, const std::string& name);
+    void zoneRead(int64_t nowNs, size_t zone, int32_t milliCelsius);
+    void cpuRead(int64_t nowNs, size_t cpu, uint64_t active, uint64_t total);
+    void actuatorAdded(int64_t nowNs, size_t actuator, const std::string& name);
+    void actuatorRead(int64_t nowNs, size_t actuator, uint32_t state);
+    void flush();
+
+  private:
+    void append(const ThermalTrace::Record& record, const std::string& name);
+    void writeLocked();
+
+    ::android::base::unique_fd mFd;
+    mutable std::mutex mLock;
+    std::vector<char> mBuffer;
+};
+
+class ThermalTraceReader {
+  public:
+    bool open(const std::string& path);
+    // Returns false at the end of the trace or on a truncated record.
+    bool next(ThermalTrace::Event* event);
+
+  private:
+    ::android::base::unique_fd mFd;
+    // Idle jiffies of every CPU as of its last read, with the bits above
+    // the 32 recorded carried over from read to read.
+    std::vector<uint64_t> mCpuIdle;
+};
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
+
+#endif  // ANDROID_HARDWARE_THERMAL_V1_1_THERMALTRACE_H
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "ThermalHAL"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/system_properties.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <android-base/properties.h>
+#include <android-base/strings.h>
+#include <log/log.h>
+#include <utils/SystemClock.h>
+
+#include "ThermalTuning.h"
+
+#define TUNING_VALUE_SIZE       64
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+ThermalTuning::ThermalTuning(const ThermalConfig& config, const ThermalWatcher& watcher)
+    : Thread(false), mConfig(config), mWatcher(watcher) {}
+
+ThermalTuning::Attribute *ThermalTuning::attribute(const std::string& dir, size_t index) {
+    Attribute& attribute = mZones[dir][index];
+    if (!attribute.probed) {
+        attribute.probed = true;
+        const std::string path = dir + "/" + kTuningAttributes[index];
+        attribute.fd.reset(TEMP_FAILURE_RETRY(open(path.c_str(), O_RDWR | O_CLOEXEC)));
+        char buf[TUNING_VALUE_SIZE];
+        const ssize_t len = attribute.fd < 0
+                ? -1
+                : TEMP_FAILURE_RETRY(pread(attribute.fd, buf, sizeof(buf) - 1, 0));
+        if (len < 0) {
+            ALOGE("%s: cannot use %s: %s", __func__, path.c_str(), strerror(errno));
+            attribute.fd.reset();
+        } else {
+            buf[len] = '\0';
+            attribute.original = ::android::base::Trim(buf);
+            attribute.value = attribute.original;
+        }
+    }
+    return attribute.fd < 0 ? nullptr : &attribute;
+}
+
+bool ThermalTuning::apply(const std::string& name, const char *source) {
+    const TuningProfile *profile = nullptr;
+    if (!name.empty() && (profile = mConfig.tuningProfile(name)) == nullptr) {
+        ALOGE("%s: no tuning profile %s", __func__, name.c_str());
+        return false;
+    }
+    const auto table = mWatcher.zoneTable();
+    if (table == nullptr) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> _lock(mLock);
+    const int64_t startNs = elapsedRealtimeNano();
+    uint32_t writes = 0;
+    uint32_t failures = 0;
+    for (size_t zone : table->live) {
+        const auto& entry = table->zones[zone];
+        const TuningValues *own = nullptr;
+        const TuningValues *all = nullptr;
+        if (profile != nullptr) {
+            auto it = profile->find(entry.name);
+            own = it != profile->end() ? &it->second : nullptr;
+            it = profile->find("*");
+            all = it != profile->end() ? &it->second : nullptr;
+        }
+        for (size_t a = 0; a < kNumTuningAttributes; ++a) {
+            const std::string *wanted = nullptr;
+            if (own != nullptr && !(*own)[a].empty()) {
+                wanted = &(*own)[a];
+            } else if (all != nullptr && !(*all)[a].empty()) {
+                wanted = &(*all)[a];
+            } else {
+                // Restore only what an earlier profile changed.
+                auto it = mZones.find(entry.dir);
+                if (it == mZones.end() || it->second[a].fd < 0 ||
+                    it->second[a].value == it->second[a].original) {
+                    continue;
+                }
+                wanted = &it->second[a].original;
+            }
+
+            Attribute *attr = attribute(entry.dir, a);
+            if (attr == nullptr) {
+                ++failures;
+                continue;
+            }
+            if (attr->value == *wanted) {
+                continue;
+            }
+            if (TEMP_FAILURE_RETRY(pwrite(attr->fd, wanted->data(), wanted->size(), 0)) !=
+                static_cast<ssize_t>(wanted->size())) {
+                ALOGE("%s: cannot set %s/%s to %s: %s", __func__, entry.dir.c_str(),
+                      kTuningAttributes[a], wanted->c_str(), strerror(errno));
+                ++failures;
+                continue;
+            }
+            attr->value = *wanted;
+            ++writes;
+        }
+    }
+
+    const int64_t endNs = elapsedRealtimeNano();
+    mRecent[mSwitchCount++ % kNumRecentSwitches] = {name, source, startNs, endNs - startNs,
+                                                    writes, failures};
+    mProfile = name;
+    ALOGI("%s: tuning profile %s from %s: %u writes, %u failed in %" PRId64 " us", __func__,
+          name.empty() ? "(kernel)" : name.c_str(), source, writes, failures,
+          (endNs - startNs) / 1000);
+    return failures == 0;
+}
+
+bool ThermalTuning::startWatchingProperty(const std::string& property) {
+    mProperty = property;
+    return run("ThermalTuning", PRIORITY_BACKGROUND) == NO_ERROR;
+}
+
+bool ThermalTuning::threadLoop() {
+    // Read before looking the property up, so that one created in between
+    // ends the wait below.
+    uint32_t serial = __system_property_area_serial();
+    const prop_info *info = __system_property_find(mProperty.c_str());
+    if (info == nullptr) {
+        __system_property_wait(nullptr, serial, &serial, nullptr);
+        return true;
+    }
+
+    serial = __system_property_serial(info);
+    if (mPropertySeen && serial == mPropertySerial &&
+        !__system_property_wait(info, mPropertySerial, &serial, nullptr)) {
+        return true;
+    }
+    const bool first = !mPropertySeen;
+    mPropertySeen = true;
+    mPropertySerial = serial;
+    const std::string profile = ::android::base::GetProperty(mProperty, "");
+    // An empty property at startup leaves the kernel as it is.
+    if (!first || !profile.empty()) {
+        apply(profile, "property");
+    }
+    return true;
+}
+
+void ThermalTuning::dump(int fd) {
+    std::lock_guard<std::mutex> _lock(mLock);
+    dprintf(fd, "Tuning:\n");
+    dprintf(fd, "  profile: %s, %" PRIu64 " switches\n",
+            mProfile.empty() ? "(kernel)" : mProfile.c_str(), mSwitchCount);
+    const std::vector<std::string> names = mConfig.tuningProfileNames();
+    dprintf(fd, "  available: %s\n",
+            names.empty() ? "-" : ::android::base::Join(names, ", ").c_str());
+    const size_t count = std::min<uint64_t>(mSwitchCount, kNumRecentSwitches);
+    for (size_t i = 0; i < count; ++i) {
+        const Switch& s = mRecent[(mSwitchCount - count + i) % kNumRecentSwitches];
+        dprintf(fd, "  %" PRId64 " ms after boot: %s from %s, %u writes, %u failed, %.3f ms\n",
+                s.atNs / 1000000, s.profile.empty() ? "(kernel)" : s.profile.c_str(), s.source,
+                s.writes, s.failures, s.durationNs / 1e6);
+    }
+    for (const auto& zone : mZones) {
+        for (size_t a = 0; a < kNumTuningAttributes; ++a) {
+            const Attribute& attr = zone.second[a];
+            if (attr.fd >= 0 && attr.value != attr.original) {
+                dprintf(fd, "  %s/%s: %s (was %s)\n", zone.first.c_str(), kTuningAttributes[a],
+                        attr.value.c_str(), attr.original.c_str());
+            }
+        }
+    }
+}
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
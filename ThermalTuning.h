@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ANDROID_HARDWARE_THERMAL_V1_1_THERMALTUNING_H
+#define ANDROID_HARDWARE_THERMAL_V1_1_THERMALTUNING_H
+
+#include <stdint.h>
+
+#include <array>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include <android-base/unique_fd.h>
+#include <utils/Thread.h>
+
+#include "ThermalConfig.h"
+#include "ThermalWatcher.h"
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+// Switches the kernel's governor and polling parameters of every zone
+// between the tuning profiles of the configuration. A switch writes only
+// the files whose value changes, all in one pass, and files the new
+// profile does not set get back the value read before the first switch.
+// Zones that appear later are tuned on the next switch.
+class ThermalTuning : public ::android::Thread {
+  public:
+    ThermalTuning(const ThermalConfig& config, const ThermalWatcher& watcher);
+
+    // Applies a profile; the empty name restores the kernel's values.
+    // Returns false if the profile does not exist or a write failed. source
+    // says who asked for it in dump().
+    bool apply(const std::string& profile, const char *source);
+
+    // Starts a thread applying the value of property whenever it changes,
+    // including the value it has now.
+    bool startWatchingProperty(const std::string& property);
+
+    void dump(int fd);
+
+  private:
+    static constexpr size_t kNumRecentSwitches = 8;
+
+    struct Attribute {
+        bool probed = false;
+        ::android::base::unique_fd fd;
+        // What the kernel had before the first write, and what it has now.
+        std::string original;
+        std::string value;
+    };
+
+    struct Switch {
+        std::string profile;
+        const char *source;
+        int64_t atNs;
+        int64_t durationNs;
+        uint32_t writes;
+        uint32_t failures;
+    };
+
+    bool threadLoop() override;
+    // Opens a file of a zone on first use; returns null if it cannot be.
+    Attribute *attribute(const std::string& dir, size_t index);
+
+    const ThermalConfig& mConfig;
+    const ThermalWatcher& mWatcher;
+    std::string mProperty;
+    // Serial of the property value last applied, valid once seen.
+    bool mPropertySeen = false;
+    uint32_t mPropertySerial = 0;
+
+    std::mutex mLock;
+    // By zone directory, indexed like kTuningAttributes; files that do not
+    // exist have no descriptor.
+    std::map<std::string, std::array<Attribute, kNumTuningAttributes>> mZones;
+    std::string mProfile;
+    uint64_t mSwitchCount = 0;
+    std::array<Switch, kNumRecentSwitches> mRecent{};
+};
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
+
+#endif  // ANDROID_HARDWARE_THERMAL_V1_1_THERMALTUNING_H
@@ -0,0 +1,1425 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "ThermalHAL"
+
+#include <ctype.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <math.h>
+#include <poll.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <iterator>
+#include <thread>
+
+#include <android-base/chrono_utils.h>
+#include <android-base/file.h>
+#include <android-base/stringprintf.h>
+#include <android-base/strings.h>
+#include <cutils/uevent.h>
+#include <log/log.h>
+
+#include "ThermalWatcher.h"
+
+#define TEMPERATURE_DIR         "/sys/class/thermal"
+#define THERMAL_DIR             "thermal_zone"
+#define POWER_SUPPLY_DIR        "/sys/class/power_supply"
+#define UEVENT_BUF_SIZE         2048
+#define UEVENT_SOCKET_RCVBUF    (64 * 1024)
+#define POLL_INTERVAL_NS        1000000000LL
+#define TELEMETRY_PERIOD_NS     1000000000LL
+#define WHEEL_TICK_NS           10000000LL
+#define WHEEL_SLOTS             512
+#define MIN_WINDOW_TRIPS        2
+#define MAX_PROBE_THREADS       4
+#define PROBE_ZONES_PER_THREAD  8
+#define MAX_TRACKED_CPUS        64
+#define CPU_DIR_FORMAT          "%s/sys/devices/system/cpu/cpu%d"
+#define CPU_ROOT_DIR            "/sys/devices/system/cpu"
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+using ::android::base::boot_clock;
+
+// Upper bounds of the sampling lateness buckets; the last bucket has none.
+static constexpr int64_t kLatenessBoundsUs[] = {
+    50, 100, 250, 500, 1000, 2000, 5000, 10000, 20000, 50000,
+};
+
+static const char *kInjectionStageNames[] = {"write", "sense", "evaluate", "notify"};
+
+// Prefix of every sysfs path, see setRootDir().
+static std::string sRootDir;
+
+static std::string sysPath(const char *path) {
+    return sRootDir + path;
+}
+
+static int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            boot_clock::now().time_since_epoch()).count();
+}
+
+ThermalWatcher::ThermalWatcher(const ThermalConfig& config, ThermalSnapshot& snapshot,
+                               ThermalJournal& journal, ThermalTimeline& timeline,
+                               const NotifyCallback& callback)
+    : Thread(false),
+      mConfig(config),
+      mSnapshot(snapshot),
+      mJournal(journal),
+      mTimeline(timeline),
+      mCallback(callback),
+      mWheel(WHEEL_TICK_NS, WHEEL_SLOTS) {}
+
+void ThermalWatcher::setRootDir(const std::string& root) {
+    sRootDir = root;
+}
+
+const std::string& ThermalWatcher::rootDir() {
+    return sRootDir;
+}
+
+ThermalWatcher::~ThermalWatcher() {
+    restoreTrips();
+    mCharger.restore();
+}
+
+bool ThermalWatcher::openEvents() {
+    if (mUeventsInjected) {
+        ALOGI("%s: taking injected uevents only", __func__);
+    } else {
+        mUeventFd.reset(uevent_open_socket(UEVENT_SOCKET_RCVBUF, true));
+        if (mUeventFd < 0) {
+            ALOGE("%s: failed to open uevent socket, polling every zone", __func__);
+            mUseTripWindow = false;
+        } else {
+            fcntl(mUeventFd, F_SETFL, O_NONBLOCK);
+        }
+    }
+    mWakeFd.reset(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK));
+    if (mWakeFd < 0) {
+        ALOGE("%s: failed to create eventfd: %s", __func__, strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+bool ThermalWatcher::discover(bool useTripWindow) {
+    mUseTripWindow = useTripWindow;
+    std::thread cpus(&ThermalWatcher::readCpuOnline, this);
+    mDiscovered = probeZones(listZones());
+    for (auto& zone : probeSupplies(&mSupplyDirs)) {
+        mDiscovered.push_back(std::move(zone));
+    }
+    cpus.join();
+    if (mDiscovered.empty()) {
+        ALOGE("%s: no thermal zones found in %s", __func__, sysPath(TEMPERATURE_DIR).c_str());
+        return false;
+    }
+    return true;
+}
+
+bool ThermalWatcher::discover(const BoardZone *zones, size_t count) {
+    // Board profiles have no writable trips to program.
+    mUseTripWindow = false;
+    std::vector<Zone> known(count);
+    std::vector<std::string> supplyDirs;
+    for (size_t i = 0; i < count; ++i) {
+        known[i].dir = sysPath(zones[i].dir);
+        known[i].type = zones[i].type;
+        // Zones are numbered in probe order, which a kernel or device tree
+        // change can shuffle; the profile only holds if every zone still
+        // measures what it says. Supplies are named after their directory.
+        std::string type;
+        if (::android::base::StartsWith(known[i].dir, sysPath(POWER_SUPPLY_DIR "/"))) {
+            known[i].supply = true;
+            known[i].unit = 0.1f;
+            supplyDirs.push_back(known[i].dir);
+            type = known[i].dir.substr(known[i].dir.find_last_of('/') + 1);
+        } else if (::android::base::ReadFileToString(known[i].dir + "/type", &type)) {
+            type = ::android::base::Trim(type);
+        }
+        if (type != known[i].type) {
+            ALOGE("%s: %s is \"%s\", not %s", __func__, zones[i].dir, type.c_str(),
+                  zones[i].type);
+            return false;
+        }
+        known[i].tempFd = std::make_shared<::android::base::unique_fd>(
+                open((known[i].dir + "/temp").c_str(), O_RDONLY | O_CLOEXEC));
+        if (*known[i].tempFd < 0) {
+            ALOGE("%s: failed to open %s/temp: %s", __func__, zones[i].dir, strerror(errno));
+            return false;
+        }
+    }
+    readCpuOnline();
+    mDiscovered = std::move(known);
+    mSupplyDirs = std::move(supplyDirs);
+    return true;
+}
+
+void ThermalWatcher::setActuators(const BoardActuator *actuators, size_t count) {
+    mActuators.clear();
+    for (size_t a = 0; a < count; ++a) {
+        Actuator actuator;
+        actuator.name = actuators[a].name;
+        actuator.stateFd.reset(TEMP_FAILURE_RETRY(open(
+                (sysPath(actuators[a].dir) + "/cur_state").c_str(), O_RDONLY | O_CLOEXEC)));
+        if (actuator.stateFd < 0) {
+            ALOGW("%s: %s has no readable state: %s", __func__, actuators[a].dir,
+                  strerror(errno));
+            continue;
+        }
+        mActuators.push_back(std::move(actuator));
+    }
+}
+
+bool ThermalWatcher::startWatching(const std::string& snapshotPath) {
+    if (!openEvents()) {
+        return false;
+    }
+    if (!mUseTripWindow) {
+        // Without uevents a trip crossing would go unnoticed.
+        for (auto& zone : mDiscovered) {
+            zone.trips.clear();
+            zone.savedTrips.clear();
+        }
+    }
+    mSnapshotPath = snapshotPath;
+    mOriginals.open(mOriginalsPath);
+    mStartNs = nowNs();
+    mWheel.start(mStartNs);
+    for (auto& zone : mDiscovered) {
+        insertZone(std::move(zone));
+    }
+    mDiscovered.clear();
+    if (mZones.empty()) {
+        return false;
+    }
+    if (!mSnapshot.open(mSnapshotPath, mZoneNames)) {
+        ALOGW("%s: residency counters will not persist", __func__);
+    }
+    for (size_t i = 0; i < mZones.size(); ++i) {
+        mEngine.restoreLevel(i, mSnapshot.level(i));
+    }
+    for (auto& actuator : mActuators) {
+        actuator.index = mSnapshot.addActuator(actuator.name);
+        if (mTrace != nullptr && actuator.index >= 0) {
+            mTrace->actuatorAdded(mStartNs, actuator.index, actuator.name);
+        }
+    }
+    for (const auto& dir : mSupplyDirs) {
+        const std::string name = dir.substr(dir.find_last_of('/') + 1);
+        mCharger.addSupply(name, dir, mConfig.chargeSteps(name), &mOriginals);
+    }
+    if (!mCharger.empty()) {
+        mChargeActuator = mSnapshot.addActuator("charge-current");
+    }
+    if (mGpu.open("", sRootDir)) {
+        mGpuActuator = mSnapshot.addActuator("gpu-devfreq");
+    }
+    mCpuIdle.open(sysPath(CPU_ROOT_DIR));
+    publishTable();
+
+    return run("ThermalWatcher", PRIORITY_HIGHEST) == NO_ERROR;
+}
+
+void ThermalWatcher::stopWatching() {
+    requestExit();
+    wake();
+    requestExitAndWait();
+}
+
+bool ThermalWatcher::publishZones() {
+    mWheel.start(nowNs());
+    for (auto& zone : mDiscovered) {
+        insertZone(std::move(zone));
+    }
+    mDiscovered.clear();
+    if (mZones.empty()) {
+        return false;
+    }
+    publishTable();
+    return true;
+}
+
+status_t ThermalWatcher::readyToRun() {
+    // Failures only cost sampling accuracy, so they are logged and ignored.
+    if (mPolicy.lockMemory && mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        ALOGE("%s: failed to lock memory: %s", __func__, strerror(errno));
+    }
+    if (!mPolicy.cpus.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : mPolicy.cpus) {
+            CPU_SET(cpu, &set);
+        }
+        if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+            ALOGE("%s: failed to set CPU affinity: %s", __func__, strerror(errno));
+        }
+    }
+    if (mPolicy.rtPriority > 0) {
+        struct sched_param param = {.sched_priority = mPolicy.rtPriority};
+        if (sched_setscheduler(0, SCHED_FIFO | SCHED_RESET_ON_FORK, &param) != 0) {
+            ALOGE("%s: failed to set SCHED_FIFO priority %d: %s", __func__,
+                  mPolicy.rtPriority, strerror(errno));
+        }
+    }
+    return NO_ERROR;
+}
+
+// Trip ids that drive a cooling device bound to the zone; the kernel
+// throttles when they are crossed, so they are not ours to move.
+static std::vector<int> boundTrips(const std::string& dir) {
+    std::vector<int> trips;
+    std::unique_ptr<DIR, int (*)(DIR*)> zone(opendir(dir.c_str()), closedir);
+    struct dirent *de;
+    while (zone != nullptr && (de = readdir(zone.get()))) {
+        std::string trip;
+        if (::android::base::StartsWith(de->d_name, "cdev") &&
+            ::android::base::EndsWith(de->d_name, "_trip_point") &&
+            ::android::base::ReadFileToString(dir + "/" + de->d_name, &trip)) {
+            trips.push_back(atoi(trip.c_str()));
+        }
+    }
+    return trips;
+}
+
+bool ThermalWatcher::probeZone(const std::string& name, Zone* zone) const {
+    zone->dir = sysPath(TEMPERATURE_DIR) + "/" + name;
+    zone->tempFd = std::make_shared<::android::base::unique_fd>(
+            open((zone->dir + "/temp").c_str(), O_RDONLY | O_CLOEXEC));
+    if (*zone->tempFd < 0 ||
+        !::android::base::ReadFileToString(zone->dir + "/type", &zone->type)) {
+        return false;
+    }
+    zone->type = ::android::base::Trim(zone->type);
+
+    const std::vector<int> bound = mUseTripWindow ? boundTrips(zone->dir) : std::vector<int>();
+    for (int id = 0; mUseTripWindow; ++id) {
+        std::string prefix = zone->dir + "/trip_point_" + std::to_string(id);
+        std::string type, temp;
+        if (!::android::base::ReadFileToString(prefix + "_type", &type) ||
+            !::android::base::ReadFileToString(prefix + "_temp", &temp)) {
+            break;
+        }
+        // Never move the trips the kernel relies on to protect the SoC.
+        type = ::android::base::Trim(type);
+        if (type == "critical" || type == "hot" ||
+            std::find(bound.begin(), bound.end(), id) != bound.end() ||
+            access((prefix + "_temp").c_str(), W_OK) != 0) {
+            continue;
+        }
+        if (zone->trips.size() == 1) {
+            zone->hystWritable = access((prefix + "_hyst").c_str(), W_OK) == 0;
+        }
+        zone->trips.push_back(id);
+        zone->savedTrips.push_back(::android::base::Trim(temp));
+    }
+    if (zone->trips.size() < MIN_WINDOW_TRIPS) {
+        zone->trips.clear();
+        zone->savedTrips.clear();
+    }
+
+    return true;
+}
+
+std::vector<ThermalWatcher::Zone> ThermalWatcher::probeZones(
+        const std::vector<std::string>& names) const {
+    // Every zone costs a handful of sysfs reads, and on a cold boot most of
+    // that is waiting on the kernel, so the probes are spread over threads.
+    std::vector<Zone> zones(names.size());
+    std::vector<char> probed(names.size());
+    const size_t workers = std::min<size_t>(
+            std::max<size_t>(1, names.size() / PROBE_ZONES_PER_THREAD), MAX_PROBE_THREADS);
+    auto probe = [&](size_t first) {
+        for (size_t i = first; i < names.size(); i += workers) {
+            probed[i] = probeZone(names[i], &zones[i]);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (size_t w = 1; w < workers; ++w) {
+        threads.emplace_back(probe, w);
+    }
+    probe(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::vector<Zone> result;
+    for (size_t i = 0; i < zones.size(); ++i) {
+        if (probed[i]) {
+            result.push_back(std::move(zones[i]));
+        }
+    }
+    return result;
+}
+
+std::vector<std::string> ThermalWatcher::listZones() const {
+    std::vector<std::string> names;
+    const std::string path = sysPath(TEMPERATURE_DIR);
+    std::unique_ptr<DIR, int (*)(DIR*)> dir(opendir(path.c_str()), closedir);
+    if (dir == nullptr) {
+        ALOGE("%s: failed to open directory %s: %s", __func__, path.c_str(), strerror(errno));
+        return names;
+    }
+
+    struct dirent *de;
+    while ((de = readdir(dir.get()))) {
+        if (!strncmp(de->d_name, THERMAL_DIR, strlen(THERMAL_DIR))) {
+            names.push_back(de->d_name);
+        }
+    }
+    return names;
+}
+
+std::vector<ThermalWatcher::Zone> ThermalWatcher::probeSupplies(
+        std::vector<std::string>* dirs) const {
+    std::vector<Zone> zones;
+    std::unique_ptr<DIR, int (*)(DIR*)> dir(opendir(sysPath(POWER_SUPPLY_DIR).c_str()), closedir);
+    if (dir == nullptr) {
+        return zones;
+    }
+
+    struct dirent *de;
+    while ((de = readdir(dir.get()))) {
+        if (de->d_name[0] == '.') {
+            continue;
+        }
+        Zone zone;
+        zone.dir = sysPath(POWER_SUPPLY_DIR) + "/" + de->d_name;
+        dirs->push_back(zone.dir);
+        zone.tempFd = std::make_shared<::android::base::unique_fd>(TEMP_FAILURE_RETRY(
+                open((zone.dir + "/temp").c_str(), O_RDONLY | O_CLOEXEC)));
+        float temperature;
+        if (*zone.tempFd < 0 || !readTemperature(*zone.tempFd, 0.1f, &temperature)) {
+            continue;
+        }
+        zone.type = de->d_name;
+        zone.supply = true;
+        zone.unit = 0.1f;
+        zones.push_back(std::move(zone));
+    }
+    return zones;
+}
+
+bool ThermalWatcher::addZone(const std::string& name) {
+    Zone zone;
+    return !isLive(sysPath(TEMPERATURE_DIR) + "/" + name) && probeZone(name, &zone) &&
+           insertZone(std::move(zone));
+}
+
+bool ThermalWatcher::isLive(const std::string& dir) const {
+    return std::any_of(mZones.begin(), mZones.end(), [&dir](const Zone& zone) {
+        return zone.dir == dir && zone.tempFd != nullptr;
+    });
+}
+
+bool ThermalWatcher::insertZone(Zone zone) {
+    size_t index = mZones.size();
+    for (size_t i = 0; i < mZones.size(); ++i) {
+        if (mZones[i].dir == zone.dir) {
+            if (mZones[i].tempFd != nullptr) {
+                return false;
+            }
+            index = i;
+        }
+    }
+
+    for (size_t i = 0; i < zone.trips.size(); ++i) {
+        zone.savedTrips[i] = mOriginals.keep(
+                zone.dir + "/trip_point_" + std::to_string(zone.trips[i]) + "_temp",
+                zone.savedTrips[i]);
+    }
+    const ZoneConfig& config = mConfig.zone(zone.type);
+    if (zone.trips.empty()) {
+        zone.basePeriodNs = config.periodMs > 0 ? config.periodMs * 1000000LL : POLL_INTERVAL_NS;
+    }
+    zone.periodNs = zone.basePeriodNs;
+    ALOGI("%s: %s (%s) uses %s", __func__, zone.dir.c_str(), zone.type.c_str(),
+          zone.trips.empty() ? "polling" : "trip window");
+
+    // Removed zones keep their index so that the engine, the snapshot and
+    // the subscriptions never see indices move.
+    std::lock_guard<std::mutex> _lock(mStatsLock);
+    if (index == mZones.size()) {
+        mEngine.addZone(config.hot, config.cold);
+        mZoneNames.push_back(zone.type);
+        mTemperatures.push_back(NAN);
+        mReadNs.push_back(0);
+        mZones.push_back(std::move(zone));
+    } else {
+        mEngine.setThresholds(index, config.hot, config.cold);
+        mZoneNames[index] = zone.type;
+        mTemperatures[index] = NAN;
+        mReadNs[index] = 0;
+        mZones[index] = std::move(zone);
+    }
+    if (mZones[index].periodNs > 0) {
+        mWheel.schedule(index, 0);
+    }
+    if (mTrace != nullptr) {
+        mTrace->zoneAdded(nowNs(), index, mZoneNames[index]);
+    }
+    return true;
+}
+
+bool ThermalWatcher::removeZone(const std::string& name) {
+    const std::string dir = sysPath(TEMPERATURE_DIR) + "/" + name;
+    for (size_t i = 0; i < mZones.size(); ++i) {
+        Zone& zone = mZones[i];
+        if (zone.dir != dir || zone.tempFd == nullptr) {
+            continue;
+        }
+
+        ALOGI("%s: %s (%s) removed", __func__, name.c_str(), zone.type.c_str());
+        // A zone that comes back starts with the trips of its driver again.
+        mOriginals.forget(zone.dir);
+        std::lock_guard<std::mutex> _lock(mStatsLock);
+        // Readers holding an older table keep the descriptor alive.
+        zone.tempFd.reset();
+        zone.trips.clear();
+        zone.savedTrips.clear();
+        zone.pending = false;
+        zone.periodNs = zone.basePeriodNs = 0;
+        mWheel.cancel(i);
+        // Accounted like a reading of nothing.
+        mTemperatures[i] = NAN;
+        mReadNs[i] = nowNs();
+        mNeedsEvaluate = true;
+        return true;
+    }
+    return false;
+}
+
+bool ThermalWatcher::rescanZones() {
+    const std::vector<std::string> names = listZones();
+    std::vector<std::string> present, added;
+    for (const auto& name : names) {
+        present.push_back(sysPath(TEMPERATURE_DIR) + "/" + name);
+        if (!isLive(present.back())) {
+            added.push_back(name);
+        }
+    }
+
+    bool changed = false;
+    for (auto& zone : probeZones(added)) {
+        changed |= insertZone(std::move(zone));
+    }
+    for (const auto& zone : mZones) {
+        if (zone.tempFd != nullptr && !zone.supply &&
+            std::find(present.begin(), present.end(), zone.dir) == present.end()) {
+            changed |= removeZone(zone.dir.substr(zone.dir.find_last_of('/') + 1));
+        }
+    }
+    return changed;
+}
+
+ZoneClass classifyZone(const std::string& type) {
+    static const std::pair<const char *, ZoneClass> kPatterns[] = {
+        {"gpu", ZoneClass::GPU},
+        {"npu", ZoneClass::NPU},
+        {"batt", ZoneClass::BATTERY},
+        {"skin", ZoneClass::SKIN},
+        {"usb", ZoneClass::USB_PORT},
+        {"cpu", ZoneClass::CPU},
+        {"cluster", ZoneClass::CPU},
+        {"soc", ZoneClass::CPU},
+        // R-Car THS channels sit on the CPU clusters.
+        {"sensor", ZoneClass::CPU},
+    };
+    std::string lower = type;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    for (const auto& pattern : kPatterns) {
+        if (lower.find(pattern.first) != std::string::npos) {
+            return pattern.second;
+        }
+    }
+    return ZoneClass::UNKNOWN;
+}
+
+CoolingClass classifyCoolingDevice(const std::string& type) {
+    static const std::pair<const char *, CoolingClass> kPatterns[] = {
+        {"fan", CoolingClass::FAN},
+        {"batt", CoolingClass::BATTERY},
+        {"charge", CoolingClass::BATTERY},
+        {"gpu", CoolingClass::GPU},
+        {"devfreq", CoolingClass::GPU},
+        {"modem", CoolingClass::MODEM},
+        {"npu", CoolingClass::NPU},
+        {"cpu", CoolingClass::CPU},
+    };
+    std::string lower = type;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    for (const auto& pattern : kPatterns) {
+        if (lower.find(pattern.first) != std::string::npos) {
+            return pattern.second;
+        }
+    }
+    return CoolingClass::COMPONENT;
+}
+
+std::vector<size_t> ThermalWatcher::ZoneTable::select(
+        const ZoneClass *zoneClass, const std::vector<std::string>& names) const {
+    std::vector<size_t> selected;
+    if (zoneClass != nullptr) {
+        selected = byClass[static_cast<size_t>(*zoneClass)];
+    }
+    for (const auto& name : names) {
+        auto it = byName.find(name);
+        if (it != byName.end()) {
+            selected.insert(selected.end(), it->second.begin(), it->second.end());
+        }
+    }
+    if (zoneClass != nullptr && names.empty()) {
+        return selected;
+    }
+    std::sort(selected.begin(), selected.end());
+    selected.erase(std::unique(selected.begin(), selected.end()), selected.end());
+    return selected;
+}
+
+void ThermalWatcher::publishTable() {
+    auto table = std::make_shared<ZoneTable>();
+    table->zones.reserve(mZones.size());
+    for (size_t i = 0; i < mZones.size(); ++i) {
+        const Zone& zone = mZones[i];
+        const ZoneClass zoneClass = zone.supply ? ZoneClass::BATTERY : classifyZone(zone.type);
+        table->zones.push_back({zone.type, zone.dir, zoneClass, zone.tempFd, zone.unit});
+        if (zone.tempFd != nullptr) {
+            table->live.push_back(i);
+            table->byClass[static_cast<size_t>(zoneClass)].push_back(i);
+            table->byName[zone.type].push_back(i);
+        }
+    }
+    std::shared_ptr<const ZoneTable> published(std::move(table));
+    std::atomic_store(&mTable, published);
+
+    TableListener listener;
+    {
+        std::lock_guard<std::mutex> _lock(mRequestLock);
+        listener = mTableListener;
+    }
+    if (listener) {
+        listener(published);
+    }
+}
+
+void ThermalWatcher::onTableChanged() {
+    if (!mSnapshot.open(mSnapshotPath, mZoneNames)) {
+        ALOGW("%s: residency counters will not persist", __func__);
+    }
+    publishTable();
+}
+
+void ThermalWatcher::readCpuOnline() {
+    uint64_t mask = 0;
+    for (int cpu = 0; cpu < MAX_TRACKED_CPUS; ++cpu) {
+        const std::string dir =
+                ::android::base::StringPrintf(CPU_DIR_FORMAT, sRootDir.c_str(), cpu);
+        if (access(dir.c_str(), F_OK) != 0) {
+            break;
+        }
+        // CPUs that cannot be unplugged have no online file.
+        std::string online;
+        if (::android::base::ReadFileToString(dir + "/online", &online) ?
+                ::android::base::Trim(online) != "0" : cpu == 0) {
+            mask |= 1ULL << cpu;
+        }
+    }
+    mCpuOnline.store(mask);
+}
+
+bool ThermalWatcher::isCpuOnline(int cpu) const {
+    if (cpu < 0 || cpu >= MAX_TRACKED_CPUS) {
+        return false;
+    }
+    return mCpuOnline.load() & (1ULL << cpu);
+}
+
+bool ThermalWatcher::readTemperature(int fd, float unit, float* temperature) {
+    char buf[16];
+    ssize_t len = TEMP_FAILURE_RETRY(pread(fd, buf, sizeof(buf) - 1, 0));
+    if (len <= 0) {
+        return false;
+    }
+    buf[len] = '\0';
+    char *end;
+    long value = strtol(buf, &end, 10);
+    if (end == buf) {
+        return false;
+    }
+    *temperature = value * unit;
+    return true;
+}
+
+bool ThermalWatcher::sampleZone(size_t index) {
+    Zone& zone = mZones[index];
+    const float previous = mTemperatures[index];
+    if (zone.tempFd == nullptr) {
+        return false;
+    }
+    if (!isnan(zone.injected)) {
+        mTemperatures[index] = zone.injected;
+    } else if (!readTemperature(*zone.tempFd, zone.unit, &mTemperatures[index])) {
+        return false;
+    }
+
+    const int64_t now = nowNs();
+    if (mReadNs[index] != 0 && !isnan(previous)) {
+        zone.slope = (mTemperatures[index] - previous) * 1e9f / (now - mReadNs[index]);
+    }
+    mReadNs[index] = now;
+    if (mTrace != nullptr) {
+        mTrace->zoneRead(now, index, lroundf(mTemperatures[index] * 1000));
+    }
+    if (mTimeline.enabled()) {
+        mTimeline.counter(ThermalTimeline::TEMPERATURE, index, mTemperatures[index], now);
+    }
+    return true;
+}
+
+void ThermalWatcher::sampleActuators(int64_t now) {
+    for (const auto& actuator : mActuators) {
+        char buf[16];
+        const ssize_t len = TEMP_FAILURE_RETRY(pread(actuator.stateFd, buf, sizeof(buf) - 1, 0));
+        if (len <= 0 || actuator.index < 0) {
+            continue;
+        }
+        buf[len] = '\0';
+        const uint32_t state = strtoul(buf, nullptr, 10);
+        mSnapshot.updateActuator(actuator.index, state, now);
+        if (mTrace != nullptr) {
+            mTrace->actuatorRead(now, actuator.index, state);
+        }
+    }
+}
+
+float ThermalWatcher::headroom() const {
+    float headroom = NAN;
+    for (size_t i = 0; i < mZones.size(); ++i) {
+        if (mZones[i].tempFd == nullptr || isnan(mTemperatures[i])) {
+            continue;
+        }
+        for (size_t l = 1; l < kNumSeverityLevels; ++l) {
+            const float hot = mEngine.hotThreshold(i, static_cast<SeverityLevel>(l));
+            if (!isnan(hot)) {
+                headroom = fminf(headroom, hot - mTemperatures[i]);
+                break;
+            }
+        }
+    }
+    return headroom;
+}
+
+void ThermalWatcher::limitCharging(int64_t now) {
+    if (mCharger.empty()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> _lock(mStatsLock);
+        if (!mCharger.update(headroom())) {
+            return;
+        }
+    }
+    if (mChargeActuator >= 0) {
+        mSnapshot.updateActuator(mChargeActuator, mCharger.state(), now);
+    }
+    // Windows below the first level wait for the next charge step instead.
+    for (size_t i = 0; i < mZones.size(); ++i) {
+        if (mZones[i].windowProgrammed && mEngine.level(i) == SeverityLevel::NONE) {
+            programWindow(i);
+        }
+    }
+}
+
+void ThermalWatcher::sampleGpu(int64_t now) {
+    GpuDevfreq::Window window;
+    if (!mGpu.isOpen() || !mGpu.sample(now, &window)) {
+        return;
+    }
+    mSnapshot.updateGpu(window.freqHz, window.coolingState, mGpu.hasLoad(), window.busyNs,
+                        window.elapsedNs);
+    if (mGpuActuator >= 0) {
+        mSnapshot.updateActuator(mGpuActuator, window.coolingState, now);
+    }
+}
+
+void ThermalWatcher::programWindow(size_t index) {
+    Zone& zone = mZones[index];
+    const SeverityLevel level = mEngine.level(index);
+
+    // The upper trip sits at the next configured level, the lower one at the
+    // point where the current level is left.
+    float upper = NAN;
+    for (size_t l = static_cast<size_t>(level) + 1; l < kNumSeverityLevels && isnan(upper); ++l) {
+        upper = mEngine.hotThreshold(index, static_cast<SeverityLevel>(l));
+    }
+    float lower = upper;
+    float hyst = 0.f;
+    if (level == SeverityLevel::NONE && !mCharger.empty() && !isnan(upper)) {
+        // Below the first level the window brackets the charge steps.
+        const float engage = mCharger.engageMargin();
+        const float release = mCharger.releaseMargin();
+        const float first = upper;
+        if (!isnan(engage)) {
+            upper = first - engage;
+        }
+        lower = isnan(release) ? upper : first - release;
+    } else if (level != SeverityLevel::NONE) {
+        lower = mEngine.hotThreshold(index, level);
+        hyst = lower - mEngine.coldThreshold(index, level);
+        if (isnan(upper)) {
+            upper = lower;
+        }
+    }
+    if (isnan(upper)) {
+        // No level is configured for this zone; nothing to wait for.
+        return;
+    }
+    if (!zone.hystWritable) {
+        lower -= hyst;
+    }
+
+    const std::string upperPath = zone.dir + "/trip_point_" + std::to_string(zone.trips[0]);
+    const std::string lowerPath = zone.dir + "/trip_point_" + std::to_string(zone.trips[1]);
+    if (!::android::base::WriteStringToFile(std::to_string(lroundf(upper * 1000)),
+                                            upperPath + "_temp") ||
+        !::android::base::WriteStringToFile(std::to_string(lroundf(lower * 1000)),
+                                            lowerPath + "_temp") ||
+        (zone.hystWritable &&
+         !::android::base::WriteStringToFile(std::to_string(lroundf(hyst * 1000)),
+                                             lowerPath + "_hyst"))) {
+        ALOGE("%s: failed to program trips of %s: %s", __func__, zone.dir.c_str(),
+              strerror(errno));
+        return;
+    }
+
+    zone.windowProgrammed = true;
+    std::lock_guard<std::mutex> _lock(mStatsLock);
+    ++mWindowWrites;
+}
+
+void ThermalWatcher::restoreTrips() {
+    for (const auto& zone : mZones) {
+        for (size_t i = 0; i < zone.trips.size(); ++i) {
+            ::android::base::WriteStringToFile(
+                    zone.savedTrips[i],
+                    zone.dir + "/trip_point_" + std::to_string(zone.trips[i]) + "_temp");
+        }
+    }
+}
+
+void ThermalWatcher::evaluate() {
+    // Before any trip or charge limit is written.
+    mOriginals.flush();
+    const int64_t now = nowNs();
+    mTransitions.clear();
+    mEngine.evaluate(mTemperatures.data(), now, &mTransitions);
+    markInjectionStage(EVALUATE);
+    mSnapshot.update(mTemperatures.data(), mReadNs.data(), mEngine.levelData(),
+                     mEngine.maxLevel(), now);
+    limitCharging(now);
+    sampleActuators(now);
+    if (mTimeline.enabled()) {
+        uint8_t states[kMaxSnapshotActuators];
+        const size_t count = mSnapshot.actuatorStates(states, kMaxSnapshotActuators);
+        mTimelineCaps.resize(count, UINT8_MAX);
+        for (size_t a = 0; a < count; ++a) {
+            if (states[a] != mTimelineCaps[a]) {
+                mTimeline.counter(ThermalTimeline::CAP, a, states[a], now);
+                mTimelineCaps[a] = states[a];
+            }
+        }
+    }
+
+    // New zones get their first window; afterwards only zones that changed
+    // level need new trips.
+    for (size_t i = 0; i < mZones.size(); ++i) {
+        if (!mZones[i].trips.empty() && !mZones[i].windowProgrammed) {
+            programWindow(i);
+        }
+    }
+
+    ThermalJournal::Record record = {};
+    if (!mTransitions.empty()) {
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        record.bootNs = now;
+        record.realtimeMs = ts.tv_sec * 1000LL + ts.tv_nsec / 1000000;
+        record.deviceLevel = static_cast<uint8_t>(mEngine.maxLevel());
+        record.actuatorCount =
+                mSnapshot.actuatorStates(record.actuatorStates, kMaxSnapshotActuators);
+    }
+
+    for (const auto& transition : mTransitions) {
+        strncpy(record.zone, mZoneNames[transition.zone].c_str(), sizeof(record.zone) - 1);
+        record.temperature = mTemperatures[transition.zone];
+        record.slope = mZones[transition.zone].slope;
+        record.from = static_cast<uint8_t>(transition.from);
+        record.to = static_cast<uint8_t>(transition.to);
+        mJournal.append(record);
+
+        if (mZones[transition.zone].windowProgrammed) {
+            programWindow(transition.zone);
+        }
+        {
+            std::lock_guard<std::mutex> _lock(mStatsLock);
+            ++mTransitionCount;
+        }
+        const bool timeline = mTimeline.enabled();
+        const int64_t notifyNs = timeline ? nowNs() : 0;
+        mCallback(mZoneNames[transition.zone], mTemperatures[transition.zone],
+                  transition.from, transition.to);
+        if (timeline) {
+            mTimeline.counter(ThermalTimeline::LEVEL, transition.zone,
+                              static_cast<double>(transition.to), notifyNs);
+            mTimeline.slice("notify", notifyNs, nowNs(), transition.zone);
+        }
+        if (mInjection != nullptr && transition.zone == mInjection->zone) {
+            markInjectionStage(NOTIFY);
+        }
+    }
+}
+
+void ThermalWatcher::handleUevents(const std::vector<std::string>& injected) {
+    char msg[UEVENT_BUF_SIZE + 2];
+    ssize_t n;
+    bool tableChanged = false;
+    while (mUeventFd >= 0 &&
+           (n = uevent_kernel_multicast_recv(mUeventFd, msg, UEVENT_BUF_SIZE)) > 0) {
+        msg[n] = '\0';
+        msg[n + 1] = '\0';
+        tableChanged |= applyUevent(msg);
+    }
+    for (const auto& event : injected) {
+        tableChanged |= applyUevent(event.c_str());
+    }
+
+    if (tableChanged) {
+        onTableChanged();
+    }
+}
+
+bool ThermalWatcher::applyUevent(const char *msg) {
+    std::string action, devpath, subsystem;
+    for (const char *cp = msg; *cp; cp += strlen(cp) + 1) {
+        if (!strncmp(cp, "ACTION=", strlen("ACTION="))) {
+            action = cp + strlen("ACTION=");
+        } else if (!strncmp(cp, "DEVPATH=", strlen("DEVPATH="))) {
+            devpath = cp + strlen("DEVPATH=");
+        } else if (!strncmp(cp, "SUBSYSTEM=", strlen("SUBSYSTEM="))) {
+            subsystem = cp + strlen("SUBSYSTEM=");
+        }
+    }
+    const std::string name = devpath.substr(devpath.find_last_of('/') + 1);
+
+    if (subsystem == "thermal") {
+        const bool isZone = ::android::base::StartsWith(name, THERMAL_DIR);
+        if (isZone && action == "add") {
+            return addZone(name);
+        } else if (isZone && action == "remove") {
+            return removeZone(name);
+        } else if (isZone) {
+            // Only the zone that sent the event needs a reading.
+            for (auto& zone : mZones) {
+                zone.pending |= zone.tempFd != nullptr &&
+                                ::android::base::EndsWith(zone.dir, "/" + name);
+            }
+        } else if (name.empty()) {
+            for (auto& zone : mZones) {
+                zone.pending |= !zone.trips.empty();
+            }
+        }
+    } else if (subsystem == "power_supply" && action == "change") {
+        // Supplies announce new readings, temperature included.
+        for (auto& zone : mZones) {
+            zone.pending |= zone.supply && zone.tempFd != nullptr &&
+                            ::android::base::EndsWith(zone.dir, "/" + name);
+        }
+    } else if (subsystem == "hwmon" && (action == "add" || action == "remove")) {
+        // Drivers registering through hwmon create or drop their thermal
+        // zones along with it.
+        return rescanZones();
+    } else if (subsystem == "cpu" && (action == "online" || action == "offline") &&
+               ::android::base::StartsWith(name, "cpu")) {
+        const int cpu = atoi(name.c_str() + strlen("cpu"));
+        if (cpu >= 0 && cpu < MAX_TRACKED_CPUS) {
+            if (action == "online") {
+                mCpuOnline.fetch_or(1ULL << cpu);
+                mCpuIdle.setOnline(cpu);
+            } else {
+                mCpuOnline.fetch_and(~(1ULL << cpu));
+            }
+        }
+    }
+    return false;
+}
+
+void ThermalWatcher::setSampleListener(const SampleListener& listener) {
+    std::lock_guard<std::mutex> _lock(mRequestLock);
+    mSampleListener = listener;
+}
+
+void ThermalWatcher::setTableListener(const TableListener& listener) {
+    std::lock_guard<std::mutex> _lock(mRequestLock);
+    mTableListener = listener;
+}
+
+void ThermalWatcher::setRequestedPeriods(const std::vector<int64_t>& periodsNs) {
+    {
+        std::lock_guard<std::mutex> _lock(mRequestLock);
+        mRequestedPeriods = periodsNs;
+        mPeriodsChanged = true;
+    }
+    wake();
+}
+
+void ThermalWatcher::injectUevent(const std::string& msg) {
+    {
+        std::lock_guard<std::mutex> _lock(mRequestLock);
+        mInjectedUevents.push_back(msg + '\0');
+    }
+    wake();
+}
+
+void ThermalWatcher::wake() {
+    if (mWakeFd < 0) {
+        // Zones were only published, there is no thread.
+        return;
+    }
+    uint64_t one = 1;
+    if (TEMP_FAILURE_RETRY(write(mWakeFd, &one, sizeof(one))) != sizeof(one)) {
+        ALOGE("%s: failed to wake watcher: %s", __func__, strerror(errno));
+    }
+}
+
+bool ThermalWatcher::injectProfile(const std::string& zoneType, int64_t stepNs,
+                                   const std::vector<float>& temperatures) {
+    std::unique_ptr<Injection> injection;
+    if (!temperatures.empty()) {
+        const auto table = zoneTable();
+        if (table == nullptr || stepNs <= 0) {
+            return false;
+        }
+        auto entry = std::find_if(table->zones.begin(), table->zones.end(),
+                                  [&zoneType](const ZoneTable::Entry& entry) {
+                                      return entry.name == zoneType && entry.tempFd != nullptr;
+                                  });
+        if (entry == table->zones.end()) {
+            return false;
+        }
+        injection = std::make_unique<Injection>();
+        injection->zone = entry - table->zones.begin();
+        injection->stepNs = stepNs;
+        injection->temperatures = temperatures;
+    }
+
+    {
+        std::lock_guard<std::mutex> _lock(mRequestLock);
+        mRequestedInjection = std::move(injection);
+        mInjectionChanged = true;
+    }
+    wake();
+    return true;
+}
+
+void ThermalWatcher::applyInjection() {
+    std::unique_ptr<Injection> injection;
+    {
+        std::lock_guard<std::mutex> _lock(mRequestLock);
+        if (!mInjectionChanged) {
+            return;
+        }
+        mInjectionChanged = false;
+        injection = std::move(mRequestedInjection);
+    }
+
+    stopInjection();
+    if (injection == nullptr) {
+        return;
+    }
+    const Zone& zone = mZones[injection->zone];
+    injection->emulated = access((zone.dir + "/emul_temp").c_str(), W_OK) == 0;
+    injection->nextNs = nowNs();
+    ALOGI("%s: injecting %zu temperatures into %s through %s", __func__,
+          injection->temperatures.size(), zone.type.c_str(),
+          injection->emulated ? "emul_temp" : "an override");
+    mInjection = std::move(injection);
+
+    std::lock_guard<std::mutex> _lock(mStatsLock);
+    mInjectedSteps = 0;
+    mStageCount.fill(0);
+    mStageSumNs.fill(0);
+    mStageMaxNs.fill(0);
+}
+
+void ThermalWatcher::stepInjection(int64_t now) {
+    finishInjectionStep();
+    Injection& injection = *mInjection;
+    Zone& zone = mZones[injection.zone];
+    if (injection.next == injection.temperatures.size() || zone.tempFd == nullptr) {
+        stopInjection();
+        return;
+    }
+
+    const float temperature = injection.temperatures[injection.next++];
+    injection.stageNs.fill(0);
+    injection.stageNs[0] = now;
+    if (injection.emulated) {
+        if (!::android::base::WriteStringToFile(std::to_string(lroundf(temperature * 1000)),
+                                                zone.dir + "/emul_temp")) {
+            ALOGE("%s: failed to write emul_temp of %s: %s", __func__, zone.dir.c_str(),
+                  strerror(errno));
+        }
+    } else {
+        zone.injected = temperature;
+    }
+    markInjectionStage(WRITE);
+    zone.pending = true;
+    injection.nextNs += injection.stepNs;
+
+    std::lock_guard<std::mutex> _lock(mStatsLock);
+    mInjectionState = ::android::base::StringPrintf(
+            "%s through %s, step %zu of %zu", zone.type.c_str(),
+            injection.emulated ? "emul_temp" : "override", injection.next,
+            injection.temperatures.size());
+}
+
+void ThermalWatcher::markInjectionStage(InjectionStage stage) {
+    if (mInjection == nullptr) {
+        return;
+    }
+    // Stages are only timed in order, once per step.
+    auto& stageNs = mInjection->stageNs;
+    if (stageNs[stage] != 0 && stageNs[stage + 1] == 0) {
+        stageNs[stage + 1] = nowNs();
+    }
+}
+
+void ThermalWatcher::finishInjectionStep() {
+    const auto& stageNs = mInjection->stageNs;
+    if (stageNs[0] == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> _lock(mStatsLock);
+    ++mInjectedSteps;
+    for (size_t s = 0; s < kNumInjectionStages && stageNs[s + 1] != 0; ++s) {
+        const int64_t durationNs = stageNs[s + 1] - stageNs[s];
+        ++mStageCount[s];
+        mStageSumNs[s] += durationNs;
+        mStageMaxNs[s] = std::max(mStageMaxNs[s], durationNs);
+    }
+}
+
+void ThermalWatcher::stopInjection() {
+    if (mInjection == nullptr) {
+        return;
+    }
+
+    finishInjectionStep();
+    Zone& zone = mZones[mInjection->zone];
+    if (mInjection->emulated) {
+        // Writing 0 hands the zone back to its sensor.
+        ::android::base::WriteStringToFile("0", zone.dir + "/emul_temp");
+    }
+    zone.injected = NAN;
+    zone.pending = true;
+    mInjection.reset();
+
+    std::lock_guard<std::mutex> _lock(mStatsLock);
+    mInjectionState += " (finished)";
+}
+
+void ThermalWatcher::applyRequestedPeriods() {
+    std::vector<int64_t> requestedPeriods;
+    {
+        std::lock_guard<std::mutex> _lock(mRequestLock);
+        if (!mPeriodsChanged) {
+            return;
+        }
+        mPeriodsChanged = false;
+        requestedPeriods = mRequestedPeriods;
+    }
+
+    // dump() reads the periods from other threads.
+    std::lock_guard<std::mutex> _lock(mStatsLock);
+    for (size_t i = 0; i < mZones.size(); ++i) {
+        Zone& zone = mZones[i];
+        const int64_t requested = i < requestedPeriods.size() ? requestedPeriods[i] : 0;
+        int64_t period = zone.basePeriodNs;
+        if (requested > 0 && (period == 0 || requested < period)) {
+            period = requested;
+        }
+        if (period != zone.periodNs) {
+            zone.periodNs = period;
+            if (period > 0) {
+                mWheel.schedule(i, 0);
+            } else {
+                mWheel.cancel(i);
+            }
+        }
+    }
+}
+
+int64_t ThermalWatcher::schedule(int64_t now) {
+    mExpired.clear();
+    mWheel.advance(now, &mExpired);
+    for (size_t i : mExpired) {
+        mZones[i].pending = true;
+        mWheel.schedule(i, mZones[i].periodNs);
+    }
+    return mWheel.nextExpiryNs(now);
+}
+
+void ThermalWatcher::recordLateness(int64_t latenessNs) {
+    static_assert(std::size(kLatenessBoundsUs) == kNumLatenessBuckets - 1,
+                  "one bound per bounded lateness bucket");
+    size_t bucket = 0;
+    while (bucket < kNumLatenessBuckets - 1 && latenessNs > kLatenessBoundsUs[bucket] * 1000) {
+        ++bucket;
+    }
+    std::lock_guard<std::mutex> _lock(mStatsLock);
+    ++mLateness[bucket];
+    mMaxLatenessNs = std::max(mMaxLatenessNs, latenessNs);
+}
+
+bool ThermalWatcher::threadLoop() {
+    applyRequestedPeriods();
+    applyInjection();
+    const int64_t now = nowNs();
+    if (mDeadlineNs != 0 && now >= mDeadlineNs) {
+        recordLateness(now - mDeadlineNs);
+    }
+    if (mInjection != nullptr && now >= mInjection->nextNs) {
+        stepInjection(now);
+    }
+    int64_t delayNs = schedule(now);
+    if (mGpu.isOpen() || mCpuIdle.isOpen()) {
+        // On a fixed period of its own, so that windows do not stretch while
+        // the zones are quiet.
+        if (now >= mTelemetryNs) {
+            sampleGpu(now);
+            if (mCpuIdle.isOpen()) {
+                mCpuIdle.sample(now);
+            }
+            mTelemetryNs += TELEMETRY_PERIOD_NS;
+            if (mTelemetryNs <= now) {
+                mTelemetryNs = now + TELEMETRY_PERIOD_NS;
+            }
+        }
+        const int64_t telemetryNs = mTelemetryNs - now;
+        delayNs = delayNs < 0 ? telemetryNs : std::min(delayNs, telemetryNs);
+    }
+    if (mInjection != nullptr) {
+        const int64_t injectNs = std::max<int64_t>(0, mInjection->nextNs - now);
+        delayNs = delayNs < 0 ? injectNs : std::min(delayNs, injectNs);
+    }
+    mDeadlineNs = delayNs >= 0 ? now + delayNs : 0;
+
+    bool updated = mNeedsEvaluate;
+    mNeedsEvaluate = false;
+    uint64_t reads = 0;
+    for (size_t i = 0; i < mZones.size(); ++i) {
+        if (mZones[i].pending) {
+            updated |= sampleZone(i);
+            mZones[i].pending = false;
+            ++reads;
+            if (mInjection != nullptr && i == mInjection->zone) {
+                markInjectionStage(SENSE);
+            }
+        }
+    }
+    if (reads > 0) {
+        std::lock_guard<std::mutex> _lock(mStatsLock);
+        mReads += reads;
+    }
+    if (updated) {
+        evaluate();
+
+        SampleListener listener;
+        {
+            std::lock_guard<std::mutex> _lock(mRequestLock);
+            listener = mSampleListener;
+        }
+        if (listener) {
+            listener(nowNs(), mTemperatures);
+        }
+    }
+    if ((reads > 0 || updated) && mTrace != nullptr) {
+        // The round's zone and actuator reads go out in one write.
+        mTrace->flush();
+    }
+    if ((reads > 0 || updated) && mTimeline.enabled()) {
+        mTimeline.slice("sample", now, nowNs(), reads);
+    }
+
+    // ppoll() keeps the timeout in nanoseconds; rounding up to whole
+    // milliseconds would show up as lateness.
+    struct timespec timeout;
+    if (mDeadlineNs != 0) {
+        const int64_t remainingNs = std::max<int64_t>(0, mDeadlineNs - nowNs());
+        timeout.tv_sec = remainingNs / 1000000000LL;
+        timeout.tv_nsec = remainingNs % 1000000000LL;
+    }
+    struct pollfd pfds[] = {
+        {.fd = mWakeFd, .events = POLLIN, .revents = 0},
+        {.fd = mUeventFd, .events = POLLIN, .revents = 0},
+    };
+    int ret = TEMP_FAILURE_RETRY(ppoll(pfds, mUeventFd >= 0 ? 2 : 1,
+                                       mDeadlineNs != 0 ? &timeout : nullptr, nullptr));
+    if (ret < 0) {
+        ALOGE("%s: poll failed: %s", __func__, strerror(errno));
+        return true;
+    }
+
+    std::vector<std::string> injected;
+    if (pfds[0].revents & POLLIN) {
+        uint64_t count;
+        TEMP_FAILURE_RETRY(read(mWakeFd, &count, sizeof(count)));
+        if (mUeventsInjected) {
+            std::lock_guard<std::mutex> _lock(mRequestLock);
+            injected.swap(mInjectedUevents);
+        }
+    }
+    if ((pfds[1].revents & POLLIN) || !injected.empty()) {
+        {
+            std::lock_guard<std::mutex> _lock(mStatsLock);
+            ++mUeventWakeups;
+        }
+        handleUevents(injected);
+    } else if (ret == 0) {
+        std::lock_guard<std::mutex> _lock(mStatsLock);
+        ++mPollWakeups;
+    }
+    return true;
+}
+
+ThermalWatcher::Stats ThermalWatcher::stats() const {
+    std::lock_guard<std::mutex> _lock(mStatsLock);
+    return {mUeventWakeups, mPollWakeups, mReads, mWindowWrites, mTransitionCount};
+}
+
+void ThermalWatcher::dump(int fd) {
+    // Everything is copied under the lock and written out after, so a slow
+    // reader of the dump never holds up the watcher thread.
+    struct ZoneState {
+        std::string type;
+        const char *mode;
+        int64_t periodNs;
+    };
+    int64_t startNs, maxLatenessNs;
+    uint64_t ueventWakeups, pollWakeups, reads, transitionCount, windowWrites, injectedSteps;
+    std::array<uint64_t, kNumLatenessBuckets> lateness;
+    std::string injectionState;
+    std::array<uint64_t, kNumInjectionStages> stageCount;
+    std::array<int64_t, kNumInjectionStages> stageSumNs, stageMaxNs;
+    std::vector<ZoneState> zones;
+    std::vector<std::string> zoneNames;
+    std::string charger;
+    {
+        std::lock_guard<std::mutex> _lock(mStatsLock);
+        startNs = mStartNs;
+        ueventWakeups = mUeventWakeups;
+        pollWakeups = mPollWakeups;
+        reads = mReads;
+        transitionCount = mTransitionCount;
+        windowWrites = mWindowWrites;
+        lateness = mLateness;
+        maxLatenessNs = mMaxLatenessNs;
+        injectionState = mInjectionState;
+        injectedSteps = mInjectedSteps;
+        stageCount = mStageCount;
+        stageSumNs = mStageSumNs;
+        stageMaxNs = mStageMaxNs;
+        zones.reserve(mZones.size());
+        for (const auto& zone : mZones) {
+            zones.push_back({zone.type,
+                             zone.tempFd == nullptr ? "removed" :
+                             zone.trips.empty() ? "polling" : "trip window",
+                             zone.periodNs});
+        }
+        zoneNames = mZoneNames;
+        mCharger.dump(&charger);
+    }
+
+    const int64_t now = nowNs();
+    const double hours = startNs ? (now - startNs) / 3600e9 : 0;
+    const double perHour = hours > 0 ? 3600e9 / (now - startNs) : 0;
+    dprintf(fd, "ThermalWatcher:\n");
+    dprintf(fd, "  uptime: %.2f h\n", hours);
+    dprintf(fd, "  uevent wakeups: %" PRIu64 " (%.1f/h)\n", ueventWakeups,
+            ueventWakeups * perHour);
+    dprintf(fd, "  poll wakeups: %" PRIu64 " (%.1f/h)\n", pollWakeups, pollWakeups * perHour);
+    dprintf(fd, "  sensor reads: %" PRIu64 " (%.1f/s)\n", reads, reads * perHour / 3600);
+    dprintf(fd, "  level transitions: %" PRIu64 "\n", transitionCount);
+    dprintf(fd, "  trip window writes: %" PRIu64 "\n", windowWrites);
+    for (const auto& zone : zones) {
+        dprintf(fd, "  %s: %s, period %" PRId64 " ms\n", zone.type.c_str(), zone.mode,
+                zone.periodNs / 1000000);
+    }
+    dprintf(fd, "  online CPUs: 0x%" PRIx64 "\n", mCpuOnline.load());
+    dprintf(fd, "  scheduling: %s priority %d, %zu pinned CPUs, memory %s\n",
+            mPolicy.rtPriority > 0 ? "SCHED_FIFO" : "SCHED_OTHER", mPolicy.rtPriority,
+            mPolicy.cpus.size(), mPolicy.lockMemory ? "locked" : "unlocked");
+    dprintf(fd, "  sampling lateness (max %" PRId64 " us):\n", maxLatenessNs / 1000);
+    for (size_t i = 0; i < kNumLatenessBuckets; ++i) {
+        if (i < kNumLatenessBuckets - 1) {
+            dprintf(fd, "    <= %6" PRId64 " us: %" PRIu64 "\n", kLatenessBoundsUs[i],
+                    lateness[i]);
+        } else {
+            dprintf(fd, "     > %6" PRId64 " us: %" PRIu64 "\n", kLatenessBoundsUs[i - 1],
+                    lateness[i]);
+        }
+    }
+    if (!injectionState.empty()) {
+        dprintf(fd, "  injection: %s\n", injectionState.c_str());
+        dprintf(fd, "  injection latency over %" PRIu64 " steps:\n", injectedSteps);
+        for (size_t s = 0; s < kNumInjectionStages; ++s) {
+            const int64_t meanNs = stageCount[s] > 0 ?
+                    stageSumNs[s] / static_cast<int64_t>(stageCount[s]) : 0;
+            dprintf(fd, "    %-8s mean %6" PRId64 " us, max %6" PRId64 " us (%" PRIu64 ")\n",
+                    kInjectionStageNames[s], meanNs / 1000, stageMaxNs[s] / 1000,
+                    stageCount[s]);
+        }
+    }
+    ::android::base::WriteStringToFd(charger, fd);
+    if (mGpu.isOpen()) {
+        mGpu.dump(fd);
+    }
+    mCpuIdle.dump(fd);
+    mEngine.dump(fd, zoneNames);
+}
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
@@ -0,0 +1,398 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ANDROID_HARDWARE_THERMAL_V1_1_THERMALWATCHER_H
+#define ANDROID_HARDWARE_THERMAL_V1_1_THERMALWATCHER_H
+
+#include <math.h>
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <android-base/unique_fd.h>
+#include <utils/Thread.h>
+
+#include "BoardProfile.h"
+#include "ChargeLimiter.h"
+#include "CpuIdle.h"
+#include "GpuDevfreq.h"
+#include "OriginalValues.h"
+#include "SeverityEngine.h"
+#include "ThermalConfig.h"
+#include "ThermalJournal.h"
+#include "ThermalSnapshot.h"
+#include "ThermalTimeline.h"
+#include "ThermalTrace.h"
+#include "TimerWheel.h"
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+// What a zone measures, numbered like the TemperatureType of HAL 2.0.
+enum class ZoneClass : uint8_t {
+    CPU,
+    GPU,
+    BATTERY,
+    SKIN,
+    USB_PORT,
+    POWER_AMPLIFIER,
+    BCL_VOLTAGE,
+    BCL_CURRENT,
+    BCL_PERCENTAGE,
+    NPU,
+    UNKNOWN,
+};
+
+constexpr size_t kNumZoneClasses = static_cast<size_t>(ZoneClass::UNKNOWN) + 1;
+
+// Guesses the class of a zone from the content of its type file.
+ZoneClass classifyZone(const std::string& type);
+
+// What a cooling device cools, numbered like the CoolingType of HAL 2.0.
+enum class CoolingClass : uint8_t {
+    FAN,
+    BATTERY,
+    CPU,
+    GPU,
+    MODEM,
+    NPU,
+    COMPONENT,
+};
+
+// Guesses the class of a cooling device from the content of its type file.
+CoolingClass classifyCoolingDevice(const std::string& type);
+
+// Watches every thermal zone and reports severity level transitions. Zones
+// with at least two writable trip points that no cooling device is bound to
+// get a window of trips programmed just below and above their current
+// level, and the thread sleeps until the kernel sends a uevent for them.
+// All other zones are polled at their configured period on a timer wheel,
+// and zones that fall due together are read in one round. Clients can
+// request faster periods for individual zones; each zone is then read once
+// per tick of the fastest period requested for it.
+//
+// Zones are added and removed as the kernel reports them on the uevent
+// socket, and CPU hotplug is tracked the same way.
+//
+// The thread can run with a real-time priority on a chosen set of CPUs so
+// that samples stay on time while the workload heats the SoC, and records
+// how late every sampling round starts relative to its scheduled tick.
+class ThermalWatcher : public ::android::Thread {
+  public:
+    // Called from the watcher thread when a zone changes severity level.
+    using NotifyCallback = std::function<void(const std::string& name, float temperature,
+                                              SeverityLevel from, SeverityLevel to)>;
+    // Called from the watcher thread after every sampling round with the
+    // latest temperature of every zone.
+    using SampleListener =
+            std::function<void(int64_t nowNs, const std::vector<float>& temperatures)>;
+
+    struct SchedulingPolicy {
+        // SCHED_FIFO priority; 0 keeps the default time-sharing policy.
+        int rtPriority = 0;
+        // CPUs the thread may run on; empty leaves the affinity alone.
+        std::vector<int> cpus;
+        // Locks the whole process in memory so a sample never waits on a
+        // page fault.
+        bool lockMemory = false;
+    };
+
+    // Prefixes the sysfs, procfs, configuration and data paths of the HAL
+    // with root, so that tests and tools can run it against a fake tree.
+    // Call before creating any Thermal.
+    static void setRootDir(const std::string& root);
+    static const std::string& rootDir();
+
+    ThermalWatcher(const ThermalConfig& config, ThermalSnapshot& snapshot,
+                   ThermalJournal& journal, ThermalTimeline& timeline,
+                   const NotifyCallback& callback);
+    ~ThermalWatcher();
+
+    // Applied by the thread itself when it starts; call before startWatching().
+    void setSchedulingPolicy(const SchedulingPolicy& policy) { mPolicy = policy; }
+    // Records every zone read to trace; call before startWatching().
+    void setTraceWriter(ThermalTraceWriter* trace) { mTrace = trace; }
+    // Keeps the trips and charge limits found at first sight in path, see
+    // OriginalValues; call before startWatching().
+    void setOriginalsPath(const std::string& path) { mOriginalsPath = path; }
+    // Finds the zones and CPUs without looking at the configuration, so it
+    // can run while the configuration is still being read.
+    bool discover(bool useTripWindow);
+    // Takes the zones of a board profile as they are instead of scanning
+    // sysfs; they are polled at their configured period. Fails if any of
+    // them cannot be opened or has another type than the profile says, in
+    // which case discover() can still be used.
+    bool discover(const BoardZone *zones, size_t count);
+    // Cooling devices whose state is recorded in the snapshot after every
+    // evaluation; call before startWatching().
+    void setActuators(const BoardActuator *actuators, size_t count);
+    // Applies the configuration to the discovered zones, opens the snapshot
+    // at snapshotPath and starts the thread.
+    bool startWatching(const std::string& snapshotPath);
+    // Stops the thread once its current round is over and waits for it.
+    void stopWatching();
+    // Takes the discovered zones like startWatching() but only publishes
+    // them, for a passive HAL whose readers read each zone themselves.
+    bool publishZones();
+    void dump(int fd);
+
+    // Immutable view of the zones, indexed like the temperatures given to
+    // listeners. Indices never move; removed zones have no descriptor.
+    struct ZoneTable {
+        struct Entry {
+            std::string name;
+            std::string dir;
+            ZoneClass zoneClass;
+            std::shared_ptr<::android::base::unique_fd> tempFd;
+            // Degrees Celsius per unit of the temp file.
+            float unit;
+        };
+        std::vector<Entry> zones;
+        // Every live zone, in ascending order.
+        std::vector<size_t> live;
+        // Live zones by class and by name, so that a query for a few zones
+        // costs the same however many there are.
+        std::array<std::vector<size_t>, kNumZoneClasses> byClass;
+        std::unordered_map<std::string, std::vector<size_t>> byName;
+
+        // Live zones of class zoneClass, if given, and those named in names,
+        // in ascending order without duplicates.
+        std::vector<size_t> select(const ZoneClass *zoneClass,
+                                   const std::vector<std::string>& names) const;
+    };
+
+    // Counters of the thread since startWatching().
+    struct Stats {
+        uint64_t ueventWakeups;
+        uint64_t pollWakeups;
+        uint64_t reads;
+        uint64_t windowWrites;
+        uint64_t transitions;
+    };
+    Stats stats() const;
+
+    // Readers get the table current at the time of the call and may keep
+    // using it while the watcher publishes a new one.
+    std::shared_ptr<const ZoneTable> zoneTable() const { return std::atomic_load(&mTable); }
+    using TableListener = std::function<void(const std::shared_ptr<const ZoneTable>& table)>;
+    bool isCpuOnline(int cpu) const;
+    // Reads which CPUs are online. The watcher thread then follows the
+    // uevents; without it, call before isCpuOnline().
+    void readCpuOnline();
+    const CpuIdle& cpuIdle() const { return mCpuIdle; }
+
+    // Reads a temperature file descriptor counting unit degrees Celsius.
+    static bool readTemperature(int fd, float unit, float* temperature);
+
+    // Replay mode: uevents only come from injectUevent(), so that tools can
+    // play the kernel's part for trip windows on a fake tree. Call before
+    // discover().
+    void useInjectedUevents() { mUeventsInjected = true; }
+    // Hands the thread a uevent as the kernel sends it, KEY=value fields
+    // each followed by a NUL.
+    void injectUevent(const std::string& msg);
+
+    // Test mode: plays temperatures into the zone of type zoneType, one every
+    // stepNs, by writing its emul_temp file or, where the kernel has none,
+    // by overriding what the watcher reads. The time every stage of the
+    // response takes is reported by dump(). An empty profile stops a
+    // running injection.
+    bool injectProfile(const std::string& zoneType, int64_t stepNs,
+                       const std::vector<float>& temperatures);
+
+    void setSampleListener(const SampleListener& listener);
+    // Called from the watcher thread with every new zone table.
+    void setTableListener(const TableListener& listener);
+    // One period per zone in nanoseconds, 0 for no request.
+    void setRequestedPeriods(const std::vector<int64_t>& periodsNs);
+
+  private:
+    struct Zone {
+        std::string dir;
+        std::string type;
+        // Null once the zone has been removed.
+        std::shared_ptr<::android::base::unique_fd> tempFd;
+        // Power supplies report tenths of a degree and are always battery
+        // temperatures; thermal zones report millidegrees.
+        bool supply = false;
+        float unit = 0.001f;
+        // Writable trip ids that are neither critical nor bound to a cooling
+        // device, with their original temperatures.
+        std::vector<int> trips;
+        std::vector<std::string> savedTrips;
+        bool hystWritable = false;
+        bool windowProgrammed = false;
+        bool pending = true;
+        // 0 for zones that are only read on uevents.
+        int64_t basePeriodNs = 0;
+        int64_t periodNs = 0;
+        float slope = 0.f;
+        // Injected temperature replacing the sensor, NAN when not injecting.
+        float injected = NAN;
+    };
+
+    // Pipeline stages timed for every injected temperature.
+    enum InjectionStage { WRITE, SENSE, EVALUATE, NOTIFY, kNumInjectionStages };
+
+    struct Injection {
+        size_t zone = 0;
+        int64_t stepNs = 0;
+        std::vector<float> temperatures;
+        bool emulated = false;
+        size_t next = 0;
+        int64_t nextNs = 0;
+        // Boot clock time each stage of the current step finished, starting
+        // with the moment the step began.
+        std::array<int64_t, kNumInjectionStages + 1> stageNs{};
+    };
+
+    struct Actuator {
+        std::string name;
+        ::android::base::unique_fd stateFd;
+        int index = -1;
+    };
+
+    status_t readyToRun() override;
+    bool openEvents();
+    bool threadLoop() override;
+    void recordLateness(int64_t latenessNs);
+    bool probeZone(const std::string& name, Zone* zone) const;
+    std::vector<Zone> probeZones(const std::vector<std::string>& names) const;
+    std::vector<std::string> listZones() const;
+    // Power supplies with a temp file, and every supply directory.
+    std::vector<Zone> probeSupplies(std::vector<std::string>* dirs) const;
+    bool isLive(const std::string& dir) const;
+    bool addZone(const std::string& name);
+    bool insertZone(Zone zone);
+    bool removeZone(const std::string& name);
+    bool rescanZones();
+    void publishTable();
+    void onTableChanged();
+    bool sampleZone(size_t index);
+    void programWindow(size_t zone);
+    void restoreTrips();
+    void evaluate();
+    void sampleActuators(int64_t nowNs);
+    // Smallest distance of a zone to its first hot threshold, NAN if none.
+    float headroom() const;
+    void limitCharging(int64_t nowNs);
+    void sampleGpu(int64_t nowNs);
+    // Reads every uevent waiting on the socket, then takes the injected ones.
+    void handleUevents(const std::vector<std::string>& injected);
+    // Returns true if the zone table changed.
+    bool applyUevent(const char *msg);
+    void applyRequestedPeriods();
+    void applyInjection();
+    void stepInjection(int64_t nowNs);
+    void markInjectionStage(InjectionStage stage);
+    void finishInjectionStep();
+    void stopInjection();
+    void wake();
+    // Marks the zones that are due as pending and returns the nanoseconds
+    // until the next one, or -1.
+    int64_t schedule(int64_t nowNs);
+
+    const ThermalConfig& mConfig;
+    ThermalSnapshot& mSnapshot;
+    ThermalJournal& mJournal;
+    ThermalTimeline& mTimeline;
+    const NotifyCallback mCallback;
+    std::vector<Zone> mZones;
+    // Zones found by discover() until startWatching() takes them.
+    std::vector<Zone> mDiscovered;
+    std::vector<std::string> mZoneNames;
+    std::vector<Actuator> mActuators;
+    // Supply directories found by discover(), handed to mCharger once the
+    // configuration is in.
+    std::vector<std::string> mSupplyDirs;
+    ChargeLimiter mCharger;
+    int mChargeActuator = -1;
+    GpuDevfreq mGpu;
+    int mGpuActuator = -1;
+    CpuIdle mCpuIdle;
+    // Latest temperature of every zone in degrees Celsius, indexed like mZones.
+    std::vector<float> mTemperatures;
+    // Boot clock time of the latest reading of every zone, 0 before the first.
+    std::vector<int64_t> mReadNs;
+    SeverityEngine mEngine;
+    std::vector<SeverityEngine::Transition> mTransitions;
+    bool mNeedsEvaluate = false;
+    bool mUseTripWindow = false;
+    bool mUeventsInjected = false;
+    std::string mOriginalsPath;
+    OriginalValues mOriginals;
+    std::string mSnapshotPath;
+    std::shared_ptr<const ZoneTable> mTable;
+    std::atomic<uint64_t> mCpuOnline{0};
+    TimerWheel mWheel;
+    std::vector<size_t> mExpired;
+    ::android::base::unique_fd mUeventFd;
+    ::android::base::unique_fd mWakeFd;
+    SchedulingPolicy mPolicy;
+    ThermalTraceWriter *mTrace = nullptr;
+    // Cooling states last put on the timeline.
+    std::vector<uint8_t> mTimelineCaps;
+    // When the GPU and cpuidle are read next.
+    int64_t mTelemetryNs = 0;
+    // Tick the next sampling round is due at, 0 when nothing is scheduled.
+    int64_t mDeadlineNs = 0;
+
+    std::mutex mRequestLock;
+    SampleListener mSampleListener;
+    TableListener mTableListener;
+    std::vector<int64_t> mRequestedPeriods;
+    bool mPeriodsChanged = false;
+    // Requested by injectProfile(), taken over by the watcher thread.
+    std::unique_ptr<Injection> mRequestedInjection;
+    bool mInjectionChanged = false;
+    std::unique_ptr<Injection> mInjection;
+    // Each ends in two NULs, like a message off the socket.
+    std::vector<std::string> mInjectedUevents;
+
+    mutable std::mutex mStatsLock;
+    int64_t mStartNs = 0;
+    uint64_t mUeventWakeups = 0;
+    uint64_t mPollWakeups = 0;
+    uint64_t mReads = 0;
+    uint64_t mTransitionCount = 0;
+    uint64_t mWindowWrites = 0;
+    // Sampling lateness histogram; bucket i counts rounds later than the
+    // previous bound and at most kLatenessBoundsUs[i].
+    static constexpr size_t kNumLatenessBuckets = 11;
+    std::array<uint64_t, kNumLatenessBuckets> mLateness{};
+    int64_t mMaxLatenessNs = 0;
+    std::string mInjectionState;
+    uint64_t mInjectedSteps = 0;
+    std::array<uint64_t, kNumInjectionStages> mStageCount{};
+    std::array<int64_t, kNumInjectionStages> mStageSumNs{};
+    std::array<int64_t, kNumInjectionStages> mStageMaxNs{};
+};
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
+
+#endif  // ANDROID_HARDWARE_THERMAL_V1_1_THERMALWATCHER_H
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+
+#include "TimerWheel.h"
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+TimerWheel::TimerWheel(int64_t tickNs, size_t slots) : mTickNs(tickNs), mSlots(slots) {}
+
+void TimerWheel::start(int64_t nowNs) {
+    mStartNs = nowNs;
+    mCurrentTick = 0;
+}
+
+void TimerWheel::schedule(size_t id, int64_t delayNs) {
+    cancel(id);
+    if (id >= mSlotOf.size()) {
+        mSlotOf.resize(id + 1, kNoSlot);
+    }
+
+    const uint64_t ticks = std::max<int64_t>(1, (delayNs + mTickNs - 1) / mTickNs);
+    const size_t slot = (mCurrentTick + ticks) % mSlots.size();
+    mSlots[slot].push_back({id, (ticks - 1) / mSlots.size()});
+    mSlotOf[id] = slot;
+    ++mArmed;
+}
+
+void TimerWheel::cancel(size_t id) {
+    if (id >= mSlotOf.size() || mSlotOf[id] == kNoSlot) {
+        return;
+    }
+
+    auto& entries = mSlots[mSlotOf[id]];
+    for (auto& entry : entries) {
+        if (entry.id == id) {
+            entry = entries.back();
+            entries.pop_back();
+            break;
+        }
+    }
+    mSlotOf[id] = kNoSlot;
+    --mArmed;
+}
+
+void TimerWheel::advance(int64_t nowNs, std::vector<size_t>* expired) {
+    const uint64_t target = (nowNs - mStartNs) / mTickNs;
+    if (mArmed == 0) {
+        mCurrentTick = std::max(mCurrentTick, target);
+        return;
+    }
+
+    while (mCurrentTick < target) {
+        ++mCurrentTick;
+        auto& entries = mSlots[mCurrentTick % mSlots.size()];
+        for (size_t i = 0; i < entries.size();) {
+            if (entries[i].rounds > 0) {
+                --entries[i].rounds;
+                ++i;
+                continue;
+            }
+            expired->push_back(entries[i].id);
+            mSlotOf[entries[i].id] = kNoSlot;
+            --mArmed;
+            entries[i] = entries.back();
+            entries.pop_back();
+        }
+    }
+}
+
+int64_t TimerWheel::nextExpiryNs(int64_t nowNs) const {
+    if (mArmed == 0) {
+        return -1;
+    }
+
+    const size_t n = mSlots.size();
+    uint64_t best = UINT64_MAX;
+    for (size_t d = 1; d <= n && best > d; ++d) {
+        for (const auto& entry : mSlots[(mCurrentTick + d) % n]) {
+            best = std::min<uint64_t>(best, d + entry.rounds * n);
+        }
+    }
+
+    const int64_t expiryNs = mStartNs + (mCurrentTick + best) * mTickNs;
+    return std::max<int64_t>(0, expiryNs - nowNs);
+}
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ANDROID_HARDWARE_THERMAL_V1_1_TIMERWHEEL_H
+#define ANDROID_HARDWARE_THERMAL_V1_1_TIMERWHEEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+// Hashed timer wheel keyed by small integer ids. Each tick only touches the
+// timers hashed to its slot; timers further away than one revolution carry
+// a round count.
+class TimerWheel {
+  public:
+    TimerWheel(int64_t tickNs, size_t slots);
+
+    void start(int64_t nowNs);
+
+    // Arms id to expire after delayNs, at least one tick from now. Re-arming
+    // an armed id moves it.
+    void schedule(size_t id, int64_t delayNs);
+    void cancel(size_t id);
+
+    // Processes every tick up to nowNs and appends the expired ids.
+    void advance(int64_t nowNs, std::vector<size_t>* expired);
+
+    // Nanoseconds until the earliest armed timer, or -1 if none is armed.
+    int64_t nextExpiryNs(int64_t nowNs) const;
+
+  private:
+    struct Entry {
+        size_t id;
+        uint64_t rounds;
+    };
+
+    static constexpr size_t kNoSlot = SIZE_MAX;
+
+    const int64_t mTickNs;
+    std::vector<std::vector<Entry>> mSlots;
+    // Slot of every id, kNoSlot when disarmed.
+    std::vector<size_t> mSlotOf;
+    size_t mArmed = 0;
+    int64_t mStartNs = 0;
+    uint64_t mCurrentTick = 0;
+};
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
+
+#endif  // ANDROID_HARDWARE_THERMAL_V1_1_TIMERWHEEL_H
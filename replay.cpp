@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "SeverityEngine.h"
+#include "ThermalConfig.h"
+#include "ThermalTrace.h"
+
+using namespace android::hardware::thermal::V1_1::renesas;
+
+static int64_t monotonicNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static void usage(const char *name) {
+    fprintf(stderr,
+            "usage: %s [-c config] [-s speed] trace\n"
+            "  -c  thresholds, in the format of thermal-renesas.conf\n"
+            "  -s  playback speed relative to the recording, 0 for as fast as possible\n",
+            name);
+}
+
+// Plays a trace recorded by the service into the severity engine and prints
+// every level transition, and every change of cooling state, with the time
+// it was reached in the recording.
+int main(int argc, char **argv) {
+    std::string configPath = "thermal-renesas.conf";
+    double speed = 0;
+    int opt;
+    while ((opt = getopt(argc, argv, "c:s:")) != -1) {
+        switch (opt) {
+            case 'c':
+                configPath = optarg;
+                break;
+            case 's':
+                speed = atof(optarg);
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (optind != argc - 1) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    ZoneConfig defaults;
+    defaults.hot.fill(NAN);
+    defaults.cold.fill(NAN);
+    ThermalConfig config(defaults);
+    if (!config.load(configPath)) {
+        fprintf(stderr, "cannot read %s\n", configPath.c_str());
+        return 1;
+    }
+    ThermalTraceReader reader;
+    if (!reader.open(argv[optind])) {
+        fprintf(stderr, "cannot read %s\n", argv[optind]);
+        return 1;
+    }
+
+    SeverityEngine engine;
+    std::vector<std::string> names;
+    std::vector<float> temperatures;
+    std::vector<SeverityEngine::Transition> transitions;
+    ThermalTrace::Event event;
+    int64_t firstNs = -1;
+    int64_t lastNs = 0;
+    const int64_t startNs = monotonicNs();
+    int64_t evaluateNs = 0;
+    std::vector<std::string> actuators;
+    std::vector<int64_t> actuatorStates;
+    uint64_t zoneReads = 0, cpuReads = 0, actuatorReads = 0, transitionCount = 0;
+
+    while (reader.next(&event)) {
+        if (firstNs < 0) {
+            firstNs = event.bootNs;
+        }
+        lastNs = event.bootNs;
+        if (speed > 0) {
+            const int64_t dueNs = startNs + (event.bootNs - firstNs) / speed;
+            const int64_t waitNs = dueNs - monotonicNs();
+            if (waitNs > 0) {
+                std::this_thread::sleep_for(std::chrono::nanoseconds(waitNs));
+            }
+        }
+
+        switch (event.kind) {
+            case ThermalTrace::ZONE_ADDED: {
+                const ZoneConfig& zone = config.zone(event.name);
+                if (event.index == names.size()) {
+                    engine.addZone(zone.hot, zone.cold);
+                    names.push_back(event.name);
+                    temperatures.push_back(NAN);
+                } else if (event.index < names.size()) {
+                    engine.setThresholds(event.index, zone.hot, zone.cold);
+                    names[event.index] = event.name;
+                }
+                break;
+            }
+            case ThermalTrace::ZONE_READ: {
+                if (event.index >= temperatures.size()) {
+                    break;
+                }
+                temperatures[event.index] = event.value / 1000.f;
+                transitions.clear();
+                const int64_t beforeNs = monotonicNs();
+                engine.evaluate(temperatures.data(), event.bootNs, &transitions);
+                evaluateNs += monotonicNs() - beforeNs;
+                ++zoneReads;
+                for (const auto& transition : transitions) {
+                    printf("%10.3f s  %s %.1f C %s -> %s\n", (event.bootNs - firstNs) / 1e9,
+                           names[transition.zone].c_str(), temperatures[transition.zone],
+                           toString(transition.from), toString(transition.to));
+                }
+                transitionCount += transitions.size();
+                break;
+            }
+            case ThermalTrace::CPU_READ:
+                ++cpuReads;
+                break;
+            case ThermalTrace::ACTUATOR_ADDED:
+                if (event.index >= actuators.size()) {
+                    actuators.resize(event.index + 1);
+                    actuatorStates.resize(event.index + 1, -1);
+                }
+                actuators[event.index] = event.name;
+                break;
+            case ThermalTrace::ACTUATOR_READ:
+                ++actuatorReads;
+                if (event.index < actuators.size() && event.value != actuatorStates[event.index]) {
+                    printf("%10.3f s  %s state %" PRId64 "\n", (event.bootNs - firstNs) / 1e9,
+                           actuators[event.index].c_str(), event.value);
+                    actuatorStates[event.index] = event.value;
+                }
+                break;
+        }
+    }
+
+    printf("\n%zu zones, %" PRIu64 " zone reads, %" PRIu64 " CPU reads, %" PRIu64
+           " actuator reads, %" PRIu64 " transitions over %.1f s of recording\n",
+           names.size(), zoneReads, cpuReads, actuatorReads, transitionCount,
+           firstNs < 0 ? 0 : (lastNs - firstNs) / 1e9);
+    printf("replayed in %.3f s, %.0f ns per evaluation\n", (monotonicNs() - startNs) / 1e9,
+           zoneReads > 0 ? static_cast<double>(evaluateNs) / zoneReads : 0);
+    fflush(stdout);
+    engine.dump(STDOUT_FILENO, names);
+    return 0;
+}
@@ -16,26 +16,90 @@
 
 #define LOG_TAG "ThermalHAL"
 
+#include <algorithm>
+#include <string>
+
 #include <android-base/logging.h>
+#include <android-base/properties.h>
 #include <android/hardware/thermal/1.1/IThermal.h>
 #include <hidl/HidlSupport.h>
 #include <hidl/HidlTransportSupport.h>
+#ifdef THERMAL_LAZY_HAL
+#include <hidl/HidlLazyUtils.h>
+#else
+#include <android/binder_manager.h>
+#include <android/binder_process.h>
+#endif
 
 #include "Thermal.h"
+#include "Thermal2.h"
+#include "ThermalAidl.h"
+#include "ThermalExt.h"
+
+#define RPC_THREADS_PROPERTY    "vendor.thermal.rpc_threads"
+#define MAX_RPC_THREADS         8
 
 using android::hardware::configureRpcThreadpool;
 using android::hardware::joinRpcThreadpool;
+#ifdef THERMAL_LAZY_HAL
+using android::hardware::LazyServiceRegistrar;
+#endif
 
 using android::hardware::thermal::V1_1::IThermal;
 using namespace android::hardware::thermal::V1_1::renesas;
 
 int main() {
-    android::sp<IThermal> thermal_hal = new Thermal;
+    // Discovery finishes in the constructor, so the first client call after
+    // registration finds warm tables.
+    android::sp<Thermal> thermal_hal = new Thermal;
+    android::sp<IThermalExt> thermal_ext = new ThermalExt(thermal_hal);
+    // The newer interfaces are adapters over the same watcher, so serving
+    // them adds no sensor reads.
+    android::sp<Thermal2> thermal_hal_2_0 = new Thermal2(thermal_hal);
+
+    // Every entry point is safe to call concurrently; devices with several
+    // busy clients can let them in at once.
+    const size_t threads = android::base::GetUintProperty<size_t>(RPC_THREADS_PROPERTY, 1,
+                                                                  MAX_RPC_THREADS);
+    configureRpcThreadpool(std::max<size_t>(threads, 1), true);
+
+    // Both HIDL versions claim android.hardware.thermal@1.0::IThermal; it
+    // ends up on the 2.0 object, whose 1.0 methods are the 1.1 ones.
+#ifdef THERMAL_LAZY_HAL
+    // The process exits once no interface has a client left. The AIDL
+    // interface is not served: its lazy registrar would shut the process
+    // down without regard to the HIDL clients, and the framework falls back
+    // to HIDL without it.
+    LazyServiceRegistrar registrar;
+    auto status = registrar.registerService(thermal_hal);
+    CHECK_EQ(status, android::OK) << "Failed to register IThermal 1.1";
+
+    status = registrar.registerService(thermal_hal_2_0);
+    CHECK_EQ(status, android::OK) << "Failed to register IThermal 2.0";
+
+    status = registrar.registerService(thermal_ext);
+    CHECK_EQ(status, android::OK) << "Failed to register IThermalExt";
+#else
+    auto status = thermal_hal->registerAsService();
+    CHECK_EQ(status, android::OK) << "Failed to register IThermal 1.1";
+
+    status = thermal_hal_2_0->registerAsService();
+    CHECK_EQ(status, android::OK) << "Failed to register IThermal 2.0";
 
-    configureRpcThreadpool(1, true);
+    status = thermal_ext->registerAsService();
+    CHECK_EQ(status, android::OK) << "Failed to register IThermalExt";
 
-    const auto status = thermal_hal->registerAsService();
-    CHECK_EQ(status, android::OK) << "Failed to register IThermal";
+    // AIDL calls arrive on binder threads of their own, sized like the
+    // hwbinder pool.
+    std::shared_ptr<ThermalAidl> thermal_aidl =
+            ndk::SharedRefBase::make<ThermalAidl>(thermal_hal);
+    const std::string instance = std::string(ThermalAidl::descriptor) + "/default";
+    CHECK_EQ(AServiceManager_addService(thermal_aidl->asBinder().get(), instance.c_str()),
+             STATUS_OK) << "Failed to register " << instance;
+    ABinderProcess_setThreadPoolMaxThreadCount(std::max<size_t>(threads, 1) - 1);
+    ABinderProcess_startThreadPool();
+#endif
+    thermal_hal->markRegistered();
 
     joinRpcThreadpool();
 }
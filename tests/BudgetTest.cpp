@@ -0,0 +1,229 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <dlfcn.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <android-base/stringprintf.h>
+#include <gtest/gtest.h>
+
+#include "FakeSysfs.h"
+#include "IoCounter.h"
+#include "Thermal.h"
+#include "Thermal2.h"
+#include "ThermalExt.h"
+
+#define IO_COUNTER_LIBRARY      "libthermal-iocounter.renesas.so"
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+static constexpr int kZones = 8;
+static constexpr int kCpus = 8;
+
+static const char *kCallNames[IO_NUM_CALLS] = {"open", "read", "write", "close", "alloc"};
+
+using Budget = std::array<uint64_t, IO_NUM_CALLS>;
+
+// Runs the HAL entry points on a fake tree with polled zones and counts
+// what one call costs on the calling thread once warmed up. A call over
+// budget fails with a diff of the budget against the counts, followed by
+// the syscalls it made.
+class BudgetTest : public ::testing::Test {
+  protected:
+    static void SetUpTestSuite() {
+        sBegin = reinterpret_cast<IoCounterBegin>(dlsym(RTLD_DEFAULT, IO_COUNTER_BEGIN));
+        sEnd = reinterpret_cast<IoCounterEnd>(dlsym(RTLD_DEFAULT, IO_COUNTER_END));
+        sSysfs = new FakeSysfs();
+        for (int z = 0; z < kZones; ++z) {
+            ASSERT_TRUE(sSysfs->addZone(z, "sensor-thermal" + std::to_string(z + 1), 40.f + z));
+        }
+        ASSERT_TRUE(sSysfs->addCpus(kCpus));
+        ThermalWatcher::setRootDir(sSysfs->root());
+        sThermal = new Thermal();
+        sThermal2 = new Thermal2(sThermal);
+        sExt = new ThermalExt(sThermal);
+        // The cached reads need the first sampling round.
+        for (int i = 0; i < 200 && isnan(sThermal->snapshot().temperature(kZones - 1)); ++i) {
+            usleep(10000);
+        }
+    }
+
+    void SetUp() override {
+        ASSERT_NE(nullptr, sBegin) << IO_COUNTER_LIBRARY << " is not preloaded";
+        ASSERT_NE(nullptr, sEnd);
+        ASSERT_NE(nullptr, sThermal->watcher()->zoneTable());
+    }
+
+    static void expectBudget(const char *method, const Budget& budget,
+                             const std::function<void()>& call) {
+        // The first calls may size buffers that later calls reuse.
+        call();
+        call();
+        IoCounts counts;
+        sBegin();
+        call();
+        sEnd(&counts);
+
+        bool over = false;
+        std::string diff = ::android::base::StringPrintf("--- budget\n+++ %s\n", method);
+        for (size_t c = 0; c < IO_NUM_CALLS; ++c) {
+            if (counts.calls[c] > budget[c]) {
+                over = true;
+                ::android::base::StringAppendF(&diff, "-%-6s %4" PRIu64 "\n+%-6s %4" PRIu64 "\n",
+                                               kCallNames[c], budget[c], kCallNames[c],
+                                               counts.calls[c]);
+            } else {
+                ::android::base::StringAppendF(&diff, " %-6s %4" PRIu64 "\n", kCallNames[c],
+                                               counts.calls[c]);
+            }
+        }
+        if (!over) {
+            return;
+        }
+        diff += "syscalls:\n";
+        for (uint32_t i = 0; i < counts.logged; ++i) {
+            char path[PATH_MAX] = "?";
+            const std::string link = "/proc/self/fd/" + std::to_string(counts.logFd[i]);
+            const ssize_t len = readlink(link.c_str(), path, sizeof(path) - 1);
+            path[len > 0 ? len : 1] = '\0';
+            ::android::base::StringAppendF(&diff, "  %s %d %s\n", kCallNames[counts.log[i]],
+                                           counts.logFd[i], path);
+        }
+        ADD_FAILURE() << diff;
+    }
+
+    static IoCounterBegin sBegin;
+    static IoCounterEnd sEnd;
+    static FakeSysfs *sSysfs;
+    static sp<Thermal> sThermal;
+    static sp<Thermal2> sThermal2;
+    static sp<ThermalExt> sExt;
+};
+
+IoCounterBegin BudgetTest::sBegin;
+IoCounterEnd BudgetTest::sEnd;
+FakeSysfs *BudgetTest::sSysfs;
+sp<Thermal> BudgetTest::sThermal;
+sp<Thermal2> BudgetTest::sThermal2;
+sp<ThermalExt> BudgetTest::sExt;
+
+// Budgets are {open, read, write, close, alloc}. The replies themselves
+// are allowed one allocation per entry and one for the vector.
+
+TEST_F(BudgetTest, GetTemperatures) {
+    // One read per zone, through descriptors opened at discovery.
+    expectBudget("getTemperatures", {0, kZones + 1, 0, 0, kZones + 1}, [] {
+        sThermal->getTemperatures([](const auto&, const auto& temperatures) {
+            EXPECT_EQ(static_cast<size_t>(kZones), temperatures.size());
+        });
+    });
+}
+
+TEST_F(BudgetTest, GetCpuUsages) {
+    // /proc/stat stays open and is read until the first line after the CPUs.
+    expectBudget("getCpuUsages", {0, 2, 0, 0, kCpus + 1}, [] {
+        sThermal->getCpuUsages([](const auto&, const auto& usages) {
+            EXPECT_EQ(static_cast<size_t>(kCpus), usages.size());
+        });
+    });
+}
+
+TEST_F(BudgetTest, GetCoolingDevices) {
+    // Served from the snapshot.
+    expectBudget("getCoolingDevices", {0, 0, 0, 0, 1}, [] {
+        sThermal->getCoolingDevices([](const auto&, const auto&) {});
+    });
+}
+
+TEST_F(BudgetTest, GetTemperaturesFilteredCached) {
+    TemperatureFilter filter = {};
+    filter.filterType = true;
+    // The R-Car sensors are CPU zones.
+    filter.type = V1_0::TemperatureType::CPU;
+    filter.cached = true;
+    expectBudget("getTemperaturesFiltered(cached)", {0, 0, 0, 0, kZones + 3}, [&filter] {
+        sExt->getTemperaturesFiltered(filter, [](const auto&, const auto& temperatures) {
+            EXPECT_EQ(static_cast<size_t>(kZones), temperatures.size());
+        });
+    });
+}
+
+TEST_F(BudgetTest, GetCurrentTemperatures) {
+    expectBudget("getCurrentTemperatures", {0, kZones + 1, 0, 0, kZones + 3}, [] {
+        sThermal2->getCurrentTemperatures(false, V2_0::TemperatureType::UNKNOWN,
+                                          [](const auto&, const auto& temperatures) {
+                                              EXPECT_EQ(static_cast<size_t>(kZones),
+                                                        temperatures.size());
+                                          });
+    });
+}
+
+TEST_F(BudgetTest, GetTemperatureThresholds) {
+    expectBudget("getTemperatureThresholds", {0, 0, 0, 0, kZones + 1}, [] {
+        sThermal2->getTemperatureThresholds(false, V2_0::TemperatureType::UNKNOWN,
+                                            [](const auto&, const auto&) {});
+    });
+}
+
+TEST_F(BudgetTest, GetCurrentCoolingDevices) {
+    expectBudget("getCurrentCoolingDevices", {0, 0, 0, 0, 1}, [] {
+        sThermal2->getCurrentCoolingDevices(false, V2_0::CoolingType::CPU,
+                                            [](const auto&, const auto&) {});
+    });
+}
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
+
+// The counters have to come before libc in symbol lookup, which only
+// LD_PRELOAD arranges; without them the test runs itself again with the
+// library installed next to it.
+int main(int argc, char **argv) {
+    if (dlsym(RTLD_DEFAULT, IO_COUNTER_BEGIN) == nullptr && getenv("LD_PRELOAD") == nullptr) {
+        char self[PATH_MAX];
+        const ssize_t len = readlink("/proc/self/exe", self, sizeof(self) - 1);
+        if (len > 0) {
+            self[len] = '\0';
+            const std::string dir = std::string(self).substr(0, std::string(self).rfind('/'));
+            for (const char *sub : {"/", "/lib64/", "/lib/"}) {
+                const std::string library = dir + sub + IO_COUNTER_LIBRARY;
+                if (access(library.c_str(), R_OK) == 0) {
+                    setenv("LD_PRELOAD", library.c_str(), 1);
+                    execv(self, argv);
+                }
+            }
+        }
+    }
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <sys/stat.h>
+
+#include <string>
+#include <vector>
+
+#include <android-base/file.h>
+#include <gtest/gtest.h>
+
+#include "ChargeLimiter.h"
+#include "OriginalValues.h"
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+// A power_supply tree in a temporary directory.
+class ChargeLimiterTest : public ::testing::Test {
+  protected:
+    std::string addSupply(const std::string& name, const std::string& type,
+                          const std::string& limitUa) {
+        const std::string dir = std::string(mRoot.path) + "/" + name;
+        mkdir(dir.c_str(), 0755);
+        EXPECT_TRUE(::android::base::WriteStringToFile(type + "\n", dir + "/type"));
+        EXPECT_TRUE(::android::base::WriteStringToFile(limitUa + "\n", limitPath(dir)));
+        return dir;
+    }
+
+    static std::string limitPath(const std::string& dir) {
+        return dir + "/constant_charge_current_max";
+    }
+
+    static uint64_t limit(const std::string& dir) {
+        std::string content;
+        EXPECT_TRUE(::android::base::ReadFileToString(limitPath(dir), &content));
+        return strtoull(content.c_str(), nullptr, 10);
+    }
+
+    std::string originalsPath() const { return std::string(mRoot.path) + "/originals"; }
+
+    TemporaryDir mRoot;
+    const std::vector<ChargeStep> mSteps = {{6.f, 75}, {4.f, 50}, {2.f, 25}};
+};
+
+TEST_F(ChargeLimiterTest, TakesOnlyBatteries) {
+    ChargeLimiter limiter;
+    EXPECT_FALSE(limiter.addSupply("usb", addSupply("usb", "USB", "3000000"), mSteps, nullptr));
+    EXPECT_FALSE(limiter.addSupply("charger", addSupply("charger", "Mains", "3000000"), mSteps,
+                                   nullptr));
+    EXPECT_TRUE(limiter.empty());
+    EXPECT_FALSE(limiter.addSupply("battery", addSupply("battery", "Battery", "2000000"), {},
+                                   nullptr));
+    EXPECT_TRUE(limiter.addSupply("battery", mRoot.path + std::string("/battery"), mSteps,
+                                  nullptr));
+    EXPECT_FALSE(limiter.empty());
+}
+
+TEST_F(ChargeLimiterTest, StepsDownAndBackWithHysteresis) {
+    const std::string dir = addSupply("battery", "Battery", "2000000");
+    ChargeLimiter limiter;
+    ASSERT_TRUE(limiter.addSupply("battery", dir, mSteps, nullptr));
+
+    EXPECT_FALSE(limiter.update(10.f));
+    EXPECT_EQ(2000000u, limit(dir));
+    EXPECT_TRUE(limiter.update(5.f));
+    EXPECT_EQ(1u, limiter.state());
+    EXPECT_EQ(1500000u, limit(dir));
+    EXPECT_TRUE(limiter.update(1.f));
+    EXPECT_EQ(3u, limiter.state());
+    EXPECT_EQ(500000u, limit(dir));
+    // Released only 2 degrees past the margin of a step.
+    EXPECT_FALSE(limiter.update(3.f));
+    EXPECT_TRUE(limiter.update(4.5f));
+    EXPECT_EQ(2u, limiter.state());
+    EXPECT_EQ(1000000u, limit(dir));
+
+    limiter.restore();
+    EXPECT_EQ(0u, limiter.state());
+    EXPECT_EQ(2000000u, limit(dir));
+}
+
+TEST_F(ChargeLimiterTest, KeepsTheOriginalLimitAcrossRestarts) {
+    const std::string dir = addSupply("battery", "Battery", "2000000");
+    {
+        OriginalValues originals;
+        originals.open(originalsPath());
+        ChargeLimiter limiter;
+        ASSERT_TRUE(limiter.addSupply("battery", dir, mSteps, &originals));
+        originals.flush();
+        ASSERT_TRUE(limiter.update(1.f));
+        // Dies without restoring.
+    }
+    ASSERT_EQ(500000u, limit(dir));
+
+    OriginalValues originals;
+    originals.open(originalsPath());
+    ChargeLimiter limiter;
+    ASSERT_TRUE(limiter.addSupply("battery", dir, mSteps, &originals));
+    ASSERT_TRUE(limiter.update(5.f));
+    EXPECT_EQ(1500000u, limit(dir));
+    limiter.restore();
+    EXPECT_EQ(2000000u, limit(dir));
+}
+
+TEST_F(ChargeLimiterTest, ForgetsValuesOfAnotherBoot) {
+    ASSERT_TRUE(::android::base::WriteStringToFile(
+            "not-this-boot\n" + limitPath(mRoot.path + std::string("/battery")) + " 9\n",
+            originalsPath()));
+    const std::string dir = addSupply("battery", "Battery", "2000000");
+    OriginalValues originals;
+    originals.open(originalsPath());
+    ChargeLimiter limiter;
+    ASSERT_TRUE(limiter.addSupply("battery", dir, mSteps, &originals));
+    ASSERT_TRUE(limiter.update(1.f));
+    limiter.restore();
+    EXPECT_EQ(2000000u, limit(dir));
+}
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
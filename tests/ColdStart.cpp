@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include <android-base/file.h>
+#include <android-base/strings.h>
+
+#include "FakeSysfs.h"
+#include "Thermal.h"
+
+#ifdef THERMAL_LAZY_HAL
+#define SERVICE_MODE            "lazy"
+#else
+#define SERVICE_MODE            "eager"
+#endif
+
+using namespace android::hardware::thermal::V1_1::renesas;
+using ::android::hardware::thermal::V1_0::ThermalStatusCode;
+
+static const char *kDataFiles[] = {"snapshot", "journal", "originals"};
+
+static int64_t boottimeNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_BOOTTIME, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Reads a "<key>: <n> kB" line of /proc/self/status.
+static int64_t statusKb(const char *key) {
+    std::string status;
+    if (!::android::base::ReadFileToString("/proc/self/status", &status)) {
+        return -1;
+    }
+    for (const auto& line : ::android::base::Split(status, "\n")) {
+        if (::android::base::StartsWith(line, key)) {
+            return strtoll(line.c_str() + strlen(key), nullptr, 10);
+        }
+    }
+    return -1;
+}
+
+static void usage(const char *name) {
+    fprintf(stderr,
+            "usage: %s [-z zones] [-n cpus] [-k runs] [-s seconds]\n"
+            "  -z  thermal zones in the fake tree, each with writable trip points\n"
+            "  -n  CPUs in the fake tree\n"
+            "  -k  runs of each kind\n"
+            "  -s  how long each service runs after its first call before its\n"
+            "      resident set is read again\n",
+            name);
+}
+
+// The service side of one run, in a process of its own: starts the HAL as
+// service.cpp does, makes the first call and reports, in ns since the
+// parent forked and in kB, when the HAL was constructed, when the first
+// call returned, and VmRSS at that point, VmHWM and VmRSS once settled.
+static int runService(const char *root, int64_t forkNs, int settleSeconds) {
+    ThermalWatcher::setRootDir(root);
+    const android::sp<Thermal> thermal = new Thermal();
+    const int64_t constructedNs = boottimeNs();
+    thermal->markRegistered();
+    bool ok = false;
+    thermal->getTemperatures([&ok](const auto& status, const auto& temperatures) {
+        ok = status.code == ThermalStatusCode::SUCCESS && temperatures.size() > 0;
+    });
+    const int64_t firstCallNs = boottimeNs();
+    const int64_t firstRssKb = statusKb("VmRSS:");
+    sleep(settleSeconds);
+    printf("%d %" PRId64 " %" PRId64 " %" PRId64 " %" PRId64 " %" PRId64 "\n", ok,
+           constructedNs - forkNs, firstCallNs - forkNs, firstRssKb, statusKb("VmHWM:"),
+           statusKb("VmRSS:"));
+    fflush(stdout);
+    // The watcher thread never returns; the process goes with it.
+    _exit(0);
+}
+
+struct Result {
+    int64_t constructedNs;
+    int64_t firstCallNs;
+    int64_t firstRssKb;
+    int64_t hwmKb;
+    int64_t settledRssKb;
+};
+
+static bool spawn(const char *self, const char *root, int settleSeconds, Result* result) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return false;
+    }
+    const std::string forkNs = std::to_string(boottimeNs());
+    const std::string settle = std::to_string(settleSeconds);
+    const pid_t pid = fork();
+    if (pid == 0) {
+        dup2(fds[1], STDOUT_FILENO);
+        close(fds[0]);
+        close(fds[1]);
+        // A fresh image, so that nothing of this process counts as resident.
+        execl(self, self, "-r", root, forkNs.c_str(), settle.c_str(), nullptr);
+        _exit(127);
+    }
+    close(fds[1]);
+    std::string line;
+    ::android::base::ReadFdToString(fds[0], &line);
+    close(fds[0]);
+    int status;
+    waitpid(pid, &status, 0);
+    int ok = 0;
+    return pid > 0 &&
+           sscanf(line.c_str(), "%d %" SCNd64 " %" SCNd64 " %" SCNd64 " %" SCNd64 " %" SCNd64,
+                  &ok, &result->constructedNs, &result->firstCallNs, &result->firstRssKb,
+                  &result->hwmKb, &result->settledRssKb) == 6 &&
+           ok;
+}
+
+// Starts the service cold, as the lazy service is started on demand, and
+// reports how long its first client waits and what it keeps resident: the
+// settled resident set is what the lazy service gives back while it has no
+// clients, and what the eager one holds all along. A first run finds no
+// snapshot; the following ones restart on the snapshot the previous one
+// left, as the lazy service does after exiting idle.
+int main(int argc, char **argv) {
+    if (argc == 5 && !strcmp(argv[1], "-r")) {
+        return runService(argv[2], strtoll(argv[3], nullptr, 10), atoi(argv[4]));
+    }
+
+    int zones = 8;
+    int cpus = 8;
+    int runs = 3;
+    int settleSeconds = 2;
+    int opt;
+    while ((opt = getopt(argc, argv, "z:n:k:s:")) != -1) {
+        switch (opt) {
+            case 'z':
+                zones = atoi(optarg);
+                break;
+            case 'n':
+                cpus = atoi(optarg);
+                break;
+            case 'k':
+                runs = atoi(optarg);
+                break;
+            case 's':
+                settleSeconds = atoi(optarg);
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (zones <= 0 || cpus <= 0 || runs <= 0 || settleSeconds < 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    FakeSysfs sysfs;
+    for (int z = 0; z < zones; ++z) {
+        if (!sysfs.addZone(z, "sensor-thermal" + std::to_string(z + 1), 45.f + z) ||
+            !sysfs.addTrip(z, 0, "passive", 150.f, 0.f) ||
+            !sysfs.addTrip(z, 1, "passive", 150.f, 0.f)) {
+            fprintf(stderr, "cannot create the fake tree in %s\n", sysfs.root());
+            return 1;
+        }
+    }
+    const std::string dataDir = std::string(sysfs.root()) + "/data/vendor/thermal";
+    if (!sysfs.addCpus(cpus) || !sysfs.write("/data/vendor/thermal/.keep", "")) {
+        fprintf(stderr, "cannot create the fake tree in %s\n", sysfs.root());
+        return 1;
+    }
+    char self[PATH_MAX];
+    const ssize_t len = readlink("/proc/self/exe", self, sizeof(self) - 1);
+    if (len <= 0) {
+        fprintf(stderr, "cannot find this executable: %s\n", strerror(errno));
+        return 1;
+    }
+    self[len] = '\0';
+
+    printf("%s service, %d zones, %d CPUs\n", SERVICE_MODE, zones, cpus);
+    printf("start     constructed ms  first call ms  call us  VmRSS kB  VmHWM kB"
+           "  settled VmRSS kB\n");
+    for (int cold = 1; cold >= 0; --cold) {
+        for (int run = 0; run < runs; ++run) {
+            if (cold) {
+                for (const char *file : kDataFiles) {
+                    unlink((dataDir + "/" + file).c_str());
+                }
+            }
+            Result result;
+            if (!spawn(self, sysfs.root(), settleSeconds, &result)) {
+                fprintf(stderr, "run %d failed\n", run);
+                return 1;
+            }
+            printf("%-8s  %14.1f  %13.1f  %7.0f  %8" PRId64 "  %8" PRId64 "  %16" PRId64 "\n",
+                   cold ? "cold" : "snapshot", result.constructedNs / 1e6,
+                   result.firstCallNs / 1e6,
+                   (result.firstCallNs - result.constructedNs) / 1e3, result.firstRssKb,
+                   result.hwmKb, result.settledRssKb);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdlib.h>
+
+#include <string>
+
+#include <android-base/file.h>
+#include <benchmark/benchmark.h>
+
+#include "CpuIdle.h"
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+static const char *kStateNames[] = {"WFI", "cpu-sleep", "cluster-sleep", "system-sleep"};
+
+// Cost of one round over a fake tree of state.range(0) CPUs with four idle
+// states each, eight files per CPU.
+static void BM_CpuIdleSample(benchmark::State& state) {
+    TemporaryDir root;
+    const int cpus = state.range(0);
+    for (int cpu = 0; cpu < cpus; ++cpu) {
+        for (int s = 0; s < 4; ++s) {
+            const std::string dir = std::string(root.path) + "/cpu" + std::to_string(cpu) +
+                                    "/cpuidle/state" + std::to_string(s);
+            if (system(("mkdir -p " + dir).c_str()) != 0 ||
+                !::android::base::WriteStringToFile(std::to_string(1000000 + s) + "\n",
+                                                    dir + "/time") ||
+                !::android::base::WriteStringToFile("123456\n", dir + "/usage") ||
+                !::android::base::WriteStringToFile(std::string(kStateNames[s]) + "\n",
+                                                    dir + "/name")) {
+                state.SkipWithError("cannot create the fake tree");
+                return;
+            }
+        }
+    }
+    CpuIdle idle;
+    if (!idle.open(root.path)) {
+        state.SkipWithError("cannot open the fake tree");
+        return;
+    }
+    int64_t nowNs = 0;
+    for (auto _ : state) {
+        nowNs += 1000000000;
+        idle.sample(nowNs);
+    }
+    state.SetItemsProcessed(state.iterations() * cpus * 8);
+}
+BENCHMARK(BM_CpuIdleSample)->RangeMultiplier(2)->Range(8, 256);
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
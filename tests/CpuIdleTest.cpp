@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+
+#include <string>
+#include <vector>
+
+#include <android-base/file.h>
+#include <gtest/gtest.h>
+
+#include "CpuIdle.h"
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+// A cpuidle tree of two CPUs with two states each in a temporary directory.
+class CpuIdleTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        for (int cpu = 0; cpu < 2; ++cpu) {
+            for (int state = 0; state < 2; ++state) {
+                ASSERT_EQ(0, system(("mkdir -p " + dir(cpu, state)).c_str()));
+                write(cpu, state, "name", state == 0 ? "WFI" : "cpu-sleep");
+                set(cpu, state, 0, 0);
+            }
+        }
+    }
+
+    std::string dir(int cpu, int state) const {
+        return std::string(mRoot.path) + "/cpu" + std::to_string(cpu) + "/cpuidle/state" +
+               std::to_string(state);
+    }
+
+    void write(int cpu, int state, const char *name, const std::string& value) {
+        ASSERT_TRUE(::android::base::WriteStringToFile(value + "\n",
+                                                       dir(cpu, state) + "/" + name));
+    }
+
+    void set(int cpu, int state, uint64_t timeUs, uint64_t usage) {
+        write(cpu, state, "time", std::to_string(timeUs));
+        write(cpu, state, "usage", std::to_string(usage));
+    }
+
+    std::vector<float> busy(const CpuIdle& idle) {
+        std::vector<CpuIdleTotal> totals;
+        std::vector<float> busy;
+        EXPECT_TRUE(idle.totals(&totals, &busy));
+        EXPECT_EQ(4u, totals.size());
+        return busy;
+    }
+
+    TemporaryDir mRoot;
+};
+
+TEST_F(CpuIdleTest, BusyShareOfTheLastWindow) {
+    CpuIdle idle;
+    ASSERT_TRUE(idle.open(mRoot.path));
+    idle.sample(1000000000);
+    EXPECT_TRUE(isnan(busy(idle)[0]));
+
+    // Over one second, cpu0 idles 250 ms in each state and cpu1 not at all.
+    set(0, 0, 250000, 10);
+    set(0, 1, 250000, 2);
+    idle.sample(2000000000);
+    const std::vector<float> shares = busy(idle);
+    ASSERT_EQ(2u, shares.size());
+    EXPECT_FLOAT_EQ(0.5f, shares[0]);
+    EXPECT_FLOAT_EQ(1.f, shares[1]);
+
+    std::vector<CpuIdleTotal> totals;
+    std::vector<float> unused;
+    ASSERT_TRUE(idle.totals(&totals, &unused));
+    EXPECT_EQ("WFI", totals[0].state);
+    EXPECT_EQ(250000u, totals[0].timeUs);
+    EXPECT_EQ(10u, totals[0].usage);
+}
+
+TEST_F(CpuIdleTest, ReopensTheFilesOfACpuComingOnline) {
+    CpuIdle idle;
+    ASSERT_TRUE(idle.open(mRoot.path));
+    idle.sample(1000000000);
+
+    // Hotplug replaces the files of cpu1; the descriptors opened before
+    // would keep reading the old ones.
+    ASSERT_EQ(0, system(("rm -rf " + std::string(mRoot.path) + "/cpu1/cpuidle").c_str()));
+    SetUp();
+    set(1, 1, 300000, 1);
+    idle.setOnline(1);
+    idle.sample(2000000000);
+    EXPECT_FLOAT_EQ(0.7f, busy(idle)[1]);
+}
+
+TEST_F(CpuIdleTest, NeedsAnIdleState) {
+    ASSERT_EQ(0, system(("rm -rf " + std::string(mRoot.path) + "/cpu0/cpuidle " +
+                         mRoot.path + "/cpu1/cpuidle").c_str()));
+    CpuIdle idle;
+    EXPECT_FALSE(idle.open(mRoot.path));
+    EXPECT_FALSE(idle.isOpen());
+}
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
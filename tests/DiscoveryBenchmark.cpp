@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <math.h>
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "FakeSysfs.h"
+#include "ThermalWatcher.h"
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+// A tree of state.range(0) zones, each with two passive trips that
+// state.range(1) has the watcher probe for a trip window, and eight CPUs.
+// Trees are built once and shared by every run with as many zones.
+static FakeSysfs *tree(benchmark::State& state) {
+    static std::map<int64_t, std::unique_ptr<FakeSysfs>> trees;
+    std::unique_ptr<FakeSysfs>& sysfs = trees[state.range(0)];
+    if (sysfs != nullptr) {
+        return sysfs.get();
+    }
+    sysfs = std::make_unique<FakeSysfs>();
+    for (int z = 0; z < state.range(0); ++z) {
+        if (!sysfs->addZone(z, "sensor-thermal" + std::to_string(z + 1), 45.f) ||
+            !sysfs->addTrip(z, 0, "passive", 100.f, 0.f) ||
+            !sysfs->addTrip(z, 1, "passive", 95.f, 2.f) ||
+            !sysfs->addTrip(z, 2, "critical", 120.f, 0.f)) {
+            state.SkipWithError("cannot create the fake tree");
+            sysfs.reset();
+            return nullptr;
+        }
+    }
+    if (!sysfs->addCpus(8)) {
+        state.SkipWithError("cannot create the fake tree");
+        sysfs.reset();
+        return nullptr;
+    }
+    return sysfs.get();
+}
+
+// Startup of a new watcher up to the point the service can register: every
+// zone found, probed and opened, and the zone table published. The tree
+// lives in the page cache, so this is the HAL's own share of a cold start;
+// on a device the first read of every sysfs attribute adds the driver's.
+static void BM_DiscoverZones(benchmark::State& state) {
+    FakeSysfs *sysfs = tree(state);
+    if (sysfs == nullptr) {
+        return;
+    }
+    ZoneConfig defaults;
+    defaults.hot.fill(NAN);
+    defaults.cold.fill(NAN);
+    const ThermalConfig config(defaults);
+    ThermalSnapshot snapshot;
+    ThermalJournal journal;
+    ThermalTimeline timeline;
+    ThermalWatcher::setRootDir(sysfs->root());
+    for (auto _ : state) {
+        sp<ThermalWatcher> watcher = new ThermalWatcher(
+                config, snapshot, journal, timeline,
+                [](const std::string&, float, SeverityLevel, SeverityLevel) {});
+        if (!watcher->discover(state.range(1)) || !watcher->publishZones()) {
+            state.SkipWithError("discovery failed");
+            break;
+        }
+        // Putting the trips back is not part of startup.
+        state.PauseTiming();
+        watcher.clear();
+        state.ResumeTiming();
+    }
+    ThermalWatcher::setRootDir("");
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DiscoverZones)
+        ->ArgNames({"zones", "trips"})
+        ->ArgsProduct({{64, 1024}, {0, 1}})
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
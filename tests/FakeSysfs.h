@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ANDROID_HARDWARE_THERMAL_V1_1_FAKESYSFS_H
+#define ANDROID_HARDWARE_THERMAL_V1_1_FAKESYSFS_H
+
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string>
+
+#include <android-base/file.h>
+#include <android-base/unique_fd.h>
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+// The part of sysfs and procfs the HAL reads, in a temporary directory, for
+// tests and tools to run it on through ThermalWatcher::setRootDir(). Zones
+// are polled unless given trip points.
+class FakeSysfs {
+  public:
+    const char *root() const { return mRoot.path; }
+
+    // Writes path, relative to the root, creating its directory.
+    bool write(const std::string& path, const std::string& value) {
+        const std::string file = std::string(mRoot.path) + path;
+        const std::string dir = file.substr(0, file.find_last_of('/'));
+        return makeDirs(dir) && ::android::base::WriteStringToFile(value + "\n", file);
+    }
+
+    // Adds thermal_zone<id> of the given type at a temperature in degrees
+    // Celsius.
+    bool addZone(int id, const std::string& type, float temperature) {
+        return write(zoneDir(id) + "/type", type) && setTemperature(id, temperature);
+    }
+
+    // Sets the temperature of zone id in degrees Celsius, see overwrite().
+    bool setTemperature(int id, float temperature) {
+        return overwrite(zoneDir(id) + "/temp", lroundf(temperature * 1000));
+    }
+
+    // Adds power supply name of the given type at a temperature in degrees
+    // Celsius, charging at up to limitUa.
+    bool addSupply(const std::string& name, const std::string& type, float temperature,
+                   uint64_t limitUa) {
+        return write(supplyDir(name) + "/type", type) &&
+               write(supplyDir(name) + "/constant_charge_current_max",
+                     std::to_string(limitUa)) &&
+               setSupplyTemperature(name, temperature);
+    }
+
+    // Like setTemperature(), in the tenths of a degree of power supplies.
+    bool setSupplyTemperature(const std::string& name, float temperature) {
+        return overwrite(supplyDir(name) + "/temp", lroundf(temperature * 10));
+    }
+
+    // Adds trip point trip of type to zone id, at and with a hysteresis of
+    // the given degrees Celsius.
+    bool addTrip(int id, int trip, const std::string& type, float temperature, float hyst) {
+        const std::string prefix = zoneDir(id) + "/trip_point_" + std::to_string(trip);
+        return write(prefix + "_type", type) &&
+               write(prefix + "_temp", std::to_string(lroundf(temperature * 1000))) &&
+               write(prefix + "_hyst", std::to_string(lroundf(hyst * 1000)));
+    }
+
+    // Adds count online CPUs, and their lines in /proc/stat.
+    bool addCpus(int count) {
+        std::string stat = "cpu  " + std::to_string(count * 100) + " 0 0 0\n";
+        for (int cpu = 0; cpu < count; ++cpu) {
+            stat += "cpu" + std::to_string(cpu) + " 100 0 50 1000 0 0 0\n";
+            if (!write("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/online", "1")) {
+                return false;
+            }
+        }
+        return write("/proc/stat", stat + "intr 0\n");
+    }
+
+    // Adds cooling_device<id> of the given type with states up to maxState.
+    bool addCoolingDevice(int id, const std::string& type, int maxState) {
+        const std::string dir = coolingDeviceDir(id);
+        return write(dir + "/type", type) && write(dir + "/max_state", std::to_string(maxState)) &&
+               setCoolingState(id, 0);
+    }
+
+    // Sets cooling_device<id> to state, as its governor would.
+    bool setCoolingState(int id, int state) {
+        return overwrite(coolingDeviceDir(id) + "/cur_state", state);
+    }
+
+    // Whether the kernel sends a uevent for zone id as its temperature goes
+    // from previous to temperature, in millidegrees, given its first trips
+    // trip points: it does when the temperature rises to a trip, and when it
+    // falls below the trip's temperature less its hysteresis.
+    bool crossesTrip(int id, int trips, long previous, long temperature) const {
+        for (int trip = 0; trip < trips; ++trip) {
+            const std::string prefix = std::string(mRoot.path) + zoneDir(id) + "/trip_point_" +
+                                       std::to_string(trip);
+            std::string tripTemperature, hyst;
+            if (!::android::base::ReadFileToString(prefix + "_temp", &tripTemperature) ||
+                !::android::base::ReadFileToString(prefix + "_hyst", &hyst) ||
+                tripTemperature.empty() || hyst.empty()) {
+                continue;
+            }
+            const long at = atol(tripTemperature.c_str());
+            const long below = at - atol(hyst.c_str());
+            if ((previous < at && temperature >= at) ||
+                (previous >= below && temperature < below)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // The change uevent of devpath, for ThermalWatcher::injectUevent().
+    static std::string changeUevent(const std::string& devpath, const std::string& subsystem) {
+        std::string msg;
+        for (const std::string& field :
+             {std::string("ACTION=change"), "DEVPATH=" + devpath, "SUBSYSTEM=" + subsystem}) {
+            msg += field;
+            msg += '\0';
+        }
+        return msg;
+    }
+
+    static std::string zoneDir(int id) {
+        return "/sys/class/thermal/thermal_zone" + std::to_string(id);
+    }
+
+    static std::string coolingDeviceDir(int id) {
+        return "/sys/class/thermal/cooling_device" + std::to_string(id);
+    }
+
+    static std::string supplyDir(const std::string& name) {
+        return "/sys/class/power_supply/" + name;
+    }
+
+  private:
+    // Overwrites path, relative to the root, in place with one write of a
+    // fixed width, so that the watcher, which keeps the file open, never
+    // reads it half written.
+    bool overwrite(const std::string& path, long value) {
+        const std::string file = std::string(mRoot.path) + path;
+        if (access(file.c_str(), F_OK) != 0 && !write(path, "")) {
+            return false;
+        }
+        ::android::base::unique_fd fd(open(file.c_str(), O_WRONLY | O_CLOEXEC));
+        char text[16];
+        const int len = snprintf(text, sizeof(text), "%-11ld\n", value);
+        return fd >= 0 && pwrite(fd, text, len, 0) == len;
+    }
+
+    static bool makeDirs(const std::string& dir) {
+        size_t slash = 0;
+        do {
+            slash = dir.find('/', slash + 1);
+            if (mkdir(dir.substr(0, slash).c_str(), 0755) != 0 && errno != EEXIST) {
+                return false;
+            }
+        } while (slash != std::string::npos);
+        return true;
+    }
+
+    TemporaryDir mRoot;
+};
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
+
+#endif  // ANDROID_HARDWARE_THERMAL_V1_1_FAKESYSFS_H
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <sys/stat.h>
+
+#include <string>
+
+#include <android-base/file.h>
+#include <gtest/gtest.h>
+
+#include "GpuDevfreq.h"
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+// A devfreq device with three frequencies in a temporary directory.
+class GpuDevfreqTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        mDir = std::string(mRoot.path) + "/fd000000.gsx";
+        ASSERT_EQ(0, mkdir(mDir.c_str(), 0755));
+        write("available_frequencies", "600000000 300000000 400000000");
+        write("cur_freq", "400000000");
+        write("max_freq", "600000000");
+        writeTransStat(1000, 1000, 0);
+    }
+
+    void write(const char *name, const std::string& value) {
+        ASSERT_TRUE(::android::base::WriteStringToFile(value + "\n", mDir + "/" + name));
+    }
+
+    // Milliseconds spent at 300, 400 and 600 MHz.
+    void writeTransStat(int ms300, int ms400, int ms600) {
+        char buf[512];
+        snprintf(buf, sizeof(buf),
+                 "     From  :   To\n"
+                 "           : 300000000 400000000 600000000   time(ms)\n"
+                 "*  300000000:         0         5         1  %d\n"
+                 "   400000000:         4         0         2  %d\n"
+                 "   600000000:         1         1         0  %d\n"
+                 "Total transition : 14",
+                 ms300, ms400, ms600);
+        write("trans_stat", buf);
+    }
+
+    TemporaryDir mRoot;
+    std::string mDir;
+};
+
+TEST_F(GpuDevfreqTest, FirstRoundIsTheBaseline) {
+    GpuDevfreq gpu;
+    ASSERT_TRUE(gpu.open(mDir));
+    EXPECT_EQ("fd000000.gsx", gpu.name());
+    EXPECT_FALSE(gpu.hasLoad());
+    GpuDevfreq::Window window;
+    EXPECT_FALSE(gpu.sample(1000000000, &window));
+    EXPECT_TRUE(gpu.sample(2000000000, &window));
+    EXPECT_EQ(1000000000, window.elapsedNs);
+    EXPECT_EQ(0, window.busyNs);
+}
+
+TEST_F(GpuDevfreqTest, MeanFrequencyAndCoolingState) {
+    GpuDevfreq gpu;
+    ASSERT_TRUE(gpu.open(mDir));
+    GpuDevfreq::Window window;
+    ASSERT_FALSE(gpu.sample(1000000000, &window));
+
+    // 500 ms at 300 MHz, 1 s at 400 MHz and 500 ms at 600 MHz.
+    writeTransStat(1500, 2000, 500);
+    write("max_freq", "400000000");
+    ASSERT_TRUE(gpu.sample(3000000000, &window));
+    EXPECT_EQ(2000000000, window.elapsedNs);
+    EXPECT_EQ(400000000u, window.freqHz);
+    EXPECT_EQ(425000000u, window.meanFreqHz);
+    // 600 MHz is above max_freq.
+    EXPECT_EQ(1u, window.coolingState);
+}
+
+TEST_F(GpuDevfreqTest, BusyTimeIsEstimatedFromTheLatestLoad) {
+    write("load", "40@400000000Hz");
+    GpuDevfreq gpu;
+    ASSERT_TRUE(gpu.open(mDir));
+    EXPECT_TRUE(gpu.hasLoad());
+    GpuDevfreq::Window window;
+    ASSERT_FALSE(gpu.sample(1000000000, &window));
+
+    write("load", "80@600000000Hz");
+    ASSERT_TRUE(gpu.sample(3000000000, &window));
+    EXPECT_EQ(1600000000, window.busyNs);
+}
+
+TEST_F(GpuDevfreqTest, NeedsCurFreq) {
+    ASSERT_EQ(0, unlink((mDir + "/cur_freq").c_str()));
+    GpuDevfreq gpu;
+    EXPECT_FALSE(gpu.open(mDir));
+}
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
@@ -0,0 +1,258 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "IoCounter.h"
+
+// dlsym() may allocate before the real allocator is known; those few
+// blocks come from here and are never freed.
+#define BOOTSTRAP_SIZE          4096
+
+static thread_local bool tCounting;
+// Set while a wrapper runs, so calls made by libc itself are not counted.
+static thread_local bool tInside;
+static thread_local IoCounts tCounts;
+
+static char sBootstrap[BOOTSTRAP_SIZE] __attribute__((aligned(16)));
+static size_t sBootstrapUsed;
+static thread_local bool tResolving;
+
+static void *resolve(const char *name) {
+    tResolving = true;
+    void *symbol = dlsym(RTLD_NEXT, name);
+    tResolving = false;
+    return symbol;
+}
+
+static void *bootstrapAlloc(size_t size) {
+    size = (size + 15) & ~static_cast<size_t>(15);
+    if (sBootstrapUsed + size > sizeof(sBootstrap)) {
+        return nullptr;
+    }
+    void *block = sBootstrap + sBootstrapUsed;
+    sBootstrapUsed += size;
+    return block;
+}
+
+static bool isBootstrap(const void *block) {
+    return block >= sBootstrap && block < sBootstrap + sizeof(sBootstrap);
+}
+
+static void count(IoCall call, int fd) {
+    if (!tCounting || tInside) {
+        return;
+    }
+    ++tCounts.calls[call];
+    if (call != IO_ALLOC && tCounts.logged < IO_COUNTER_LOG_SIZE) {
+        tCounts.log[tCounts.logged] = call;
+        tCounts.logFd[tCounts.logged] = fd;
+        ++tCounts.logged;
+    }
+}
+
+static mode_t modeOf(int flags, va_list args) {
+    return (flags & O_CREAT) || (flags & O_TMPFILE) == O_TMPFILE ? va_arg(args, int) : 0;
+}
+
+// The descriptor an open returned, for the log.
+static int openedFd(int result) {
+    return result;
+}
+
+template <typename Result>
+static int openedFd(Result /* result */) {
+    return -1;
+}
+
+// Calls the real function, counting the call unless libc made it from
+// within another wrapper.
+template <typename Result, typename Real, typename... Args>
+static Result forward(Real real, IoCall call, int fd, Args... args) {
+    const bool nested = tInside;
+    tInside = true;
+    const Result result = real(args...);
+    tInside = nested;
+    if (!nested) {
+        count(call, call == IO_OPEN ? openedFd(result) : fd);
+    }
+    return result;
+}
+
+#define REAL(name, type) \
+    static const auto real = reinterpret_cast<type>(resolve(name))
+
+extern "C" {
+
+void thermal_io_counter_begin() {
+    memset(&tCounts, 0, sizeof(tCounts));
+    tCounting = true;
+}
+
+void thermal_io_counter_end(IoCounts* counts) {
+    tCounting = false;
+    *counts = tCounts;
+}
+
+int open(const char *path, int flags, ...) {
+    REAL("open", int (*)(const char *, int, ...));
+    va_list args;
+    va_start(args, flags);
+    const mode_t mode = modeOf(flags, args);
+    va_end(args);
+    return forward<int>(real, IO_OPEN, -1, path, flags, mode);
+}
+
+int open64(const char *path, int flags, ...) {
+    REAL("open64", int (*)(const char *, int, ...));
+    va_list args;
+    va_start(args, flags);
+    const mode_t mode = modeOf(flags, args);
+    va_end(args);
+    return forward<int>(real, IO_OPEN, -1, path, flags, mode);
+}
+
+int openat(int dirFd, const char *path, int flags, ...) {
+    REAL("openat", int (*)(int, const char *, int, ...));
+    va_list args;
+    va_start(args, flags);
+    const mode_t mode = modeOf(flags, args);
+    va_end(args);
+    return forward<int>(real, IO_OPEN, -1, dirFd, path, flags, mode);
+}
+
+int __open_2(const char *path, int flags) {
+    REAL("__open_2", int (*)(const char *, int));
+    return forward<int>(real, IO_OPEN, -1, path, flags);
+}
+
+int __openat_2(int dirFd, const char *path, int flags) {
+    REAL("__openat_2", int (*)(int, const char *, int));
+    return forward<int>(real, IO_OPEN, -1, dirFd, path, flags);
+}
+
+ssize_t read(int fd, void *buf, size_t count) {
+    REAL("read", ssize_t (*)(int, void *, size_t));
+    return forward<ssize_t>(real, IO_READ, fd, fd, buf, count);
+}
+
+ssize_t __read_chk(int fd, void *buf, size_t count, size_t size) {
+    REAL("__read_chk", ssize_t (*)(int, void *, size_t, size_t));
+    return forward<ssize_t>(real, IO_READ, fd, fd, buf, count, size);
+}
+
+ssize_t pread(int fd, void *buf, size_t count, off_t offset) {
+    REAL("pread", ssize_t (*)(int, void *, size_t, off_t));
+    return forward<ssize_t>(real, IO_READ, fd, fd, buf, count, offset);
+}
+
+ssize_t pread64(int fd, void *buf, size_t count, off64_t offset) {
+    REAL("pread64", ssize_t (*)(int, void *, size_t, off64_t));
+    return forward<ssize_t>(real, IO_READ, fd, fd, buf, count, offset);
+}
+
+ssize_t __pread_chk(int fd, void *buf, size_t count, off_t offset, size_t size) {
+    REAL("__pread_chk", ssize_t (*)(int, void *, size_t, off_t, size_t));
+    return forward<ssize_t>(real, IO_READ, fd, fd, buf, count, offset, size);
+}
+
+ssize_t __pread64_chk(int fd, void *buf, size_t count, off64_t offset, size_t size) {
+    REAL("__pread64_chk", ssize_t (*)(int, void *, size_t, off64_t, size_t));
+    return forward<ssize_t>(real, IO_READ, fd, fd, buf, count, offset, size);
+}
+
+ssize_t write(int fd, const void *buf, size_t count) {
+    REAL("write", ssize_t (*)(int, const void *, size_t));
+    return forward<ssize_t>(real, IO_WRITE, fd, fd, buf, count);
+}
+
+ssize_t pwrite(int fd, const void *buf, size_t count, off_t offset) {
+    REAL("pwrite", ssize_t (*)(int, const void *, size_t, off_t));
+    return forward<ssize_t>(real, IO_WRITE, fd, fd, buf, count, offset);
+}
+
+ssize_t pwrite64(int fd, const void *buf, size_t count, off64_t offset) {
+    REAL("pwrite64", ssize_t (*)(int, const void *, size_t, off64_t));
+    return forward<ssize_t>(real, IO_WRITE, fd, fd, buf, count, offset);
+}
+
+int close(int fd) {
+    REAL("close", int (*)(int));
+    return forward<int>(real, IO_CLOSE, fd, fd);
+}
+
+void *malloc(size_t size) {
+    if (tResolving) {
+        return bootstrapAlloc(size);
+    }
+    REAL("malloc", void *(*)(size_t));
+    return forward<void *>(real, IO_ALLOC, -1, size);
+}
+
+void *calloc(size_t count, size_t size) {
+    if (tResolving) {
+        // The arena is zeroed and never reused.
+        return bootstrapAlloc(count * size);
+    }
+    REAL("calloc", void *(*)(size_t, size_t));
+    return forward<void *>(real, IO_ALLOC, -1, count, size);
+}
+
+void *realloc(void *block, size_t size) {
+    REAL("realloc", void *(*)(void *, size_t));
+    if (isBootstrap(block)) {
+        void *moved = malloc(size);
+        if (moved != nullptr) {
+            memcpy(moved, block, std::min<size_t>(size, sBootstrap + sizeof(sBootstrap) -
+                                                               static_cast<char *>(block)));
+        }
+        return moved;
+    }
+    return forward<void *>(real, IO_ALLOC, -1, block, size);
+}
+
+int posix_memalign(void **block, size_t alignment, size_t size) {
+    REAL("posix_memalign", int (*)(void **, size_t, size_t));
+    return forward<int>(real, IO_ALLOC, -1, block, alignment, size);
+}
+
+void *aligned_alloc(size_t alignment, size_t size) {
+    REAL("aligned_alloc", void *(*)(size_t, size_t));
+    return forward<void *>(real, IO_ALLOC, -1, alignment, size);
+}
+
+void *memalign(size_t alignment, size_t size) {
+    REAL("memalign", void *(*)(size_t, size_t));
+    return forward<void *>(real, IO_ALLOC, -1, alignment, size);
+}
+
+void free(void *block) {
+    if (block == nullptr || isBootstrap(block)) {
+        return;
+    }
+    REAL("free", void (*)(void *));
+    real(block);
+}
+
+}  // extern "C"
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ANDROID_HARDWARE_THERMAL_V1_1_IOCOUNTER_H
+#define ANDROID_HARDWARE_THERMAL_V1_1_IOCOUNTER_H
+
+#include <stdint.h>
+
+// Interface of libthermal-iocounter, which is loaded with LD_PRELOAD and
+// wraps the file syscalls and the allocator of libc. Only the thread
+// between begin and end is counted, so the watcher thread does not skew
+// the counts of a HAL call.
+
+#define IO_COUNTER_LOG_SIZE     64
+
+enum IoCall {
+    IO_OPEN,
+    IO_READ,
+    IO_WRITE,
+    IO_CLOSE,
+    IO_ALLOC,
+    IO_NUM_CALLS,
+};
+
+struct IoCounts {
+    uint64_t calls[IO_NUM_CALLS];
+    // The first IO_COUNTER_LOG_SIZE syscalls, as the call and the file
+    // descriptor it used or, for an open, returned.
+    uint32_t logged;
+    IoCall log[IO_COUNTER_LOG_SIZE];
+    int logFd[IO_COUNTER_LOG_SIZE];
+};
+
+extern "C" {
+using IoCounterBegin = void (*)();
+using IoCounterEnd = void (*)(IoCounts* counts);
+}
+
+#define IO_COUNTER_BEGIN        "thermal_io_counter_begin"
+#define IO_COUNTER_END          "thermal_io_counter_end"
+
+#endif  // ANDROID_HARDWARE_THERMAL_V1_1_IOCOUNTER_H
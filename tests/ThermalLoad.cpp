@@ -0,0 +1,334 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <android-base/strings.h>
+
+#include "FakeSysfs.h"
+#include "Thermal.h"
+#include "ThermalExt.h"
+
+using namespace android::hardware::thermal::V1_1::renesas;
+using ::android::hardware::thermal::V1_0::ThermalStatusCode;
+
+enum Method { TEMPERATURES, CPU_USAGES, COOLING_DEVICES, NUM_METHODS };
+
+static const char *kMethodNames[NUM_METHODS] = {"getTemperatures", "getCpuUsages",
+                                                "getCoolingDevices"};
+
+static int64_t monotonicNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static void usage(const char *name) {
+    fprintf(stderr,
+            "usage: %s [-z zones] [-n cpus] [-k clients] [-d seconds] [-m mix] [-q rate]\n"
+            "          [-t threads] [-c modes]\n"
+            "  -z  thermal zones in the fake tree\n"
+            "  -n  CPUs in the fake tree\n"
+            "  -k  client threads\n"
+            "  -d  length of each run\n"
+            "  -m  weights of getTemperatures:getCpuUsages:getCoolingDevices, e.g. 6:3:1\n"
+            "  -q  calls per second of each client, 0 for back to back\n"
+            "  -t  threadpool sizes to run with, e.g. 1,2,4\n"
+            "  -c  caching modes to run with: live reads the sensors on every call,\n"
+            "      cached takes the watcher's last sample through IThermalExt\n",
+            name);
+}
+
+static bool parseList(const char *text, std::vector<int>* values) {
+    values->clear();
+    for (const auto& field : ::android::base::Split(text, ",:")) {
+        char *end;
+        const long value = strtol(field.c_str(), &end, 10);
+        if (end == field.c_str() || *end != '\0' || value < 0) {
+            return false;
+        }
+        values->push_back(value);
+    }
+    return !values->empty();
+}
+
+// Stands in for the hwbinder threadpool, which passthrough mode has none
+// of: at most size calls are in the HAL at once and the others queue.
+class Threadpool {
+  public:
+    explicit Threadpool(int size) : mFree(size) {}
+
+    void enter() {
+        std::unique_lock<std::mutex> lock(mLock);
+        mCondition.wait(lock, [this] { return mFree > 0; });
+        --mFree;
+    }
+
+    void leave() {
+        {
+            std::lock_guard<std::mutex> _lock(mLock);
+            ++mFree;
+        }
+        mCondition.notify_one();
+    }
+
+  private:
+    std::mutex mLock;
+    std::condition_variable mCondition;
+    int mFree;
+};
+
+struct Run {
+    int threads;
+    bool cached;
+    int clients;
+    int64_t lengthNs;
+    double rate;
+    std::vector<int> mix;
+    // Every zone of the tree, for the cached mode.
+    TemperatureFilter filter;
+};
+
+static bool call(Thermal* thermal, ThermalExt* ext, const Run& run, Method method) {
+    bool ok = false;
+    switch (method) {
+        case TEMPERATURES:
+            if (run.cached) {
+                ext->getTemperaturesFiltered(run.filter, [&ok](const auto& status, const auto&) {
+                    ok = status.code == ThermalStatusCode::SUCCESS;
+                });
+            } else {
+                thermal->getTemperatures([&ok](const auto& status, const auto&) {
+                    ok = status.code == ThermalStatusCode::SUCCESS;
+                });
+            }
+            break;
+        case CPU_USAGES:
+            thermal->getCpuUsages([&ok](const auto& status, const auto&) {
+                ok = status.code == ThermalStatusCode::SUCCESS;
+            });
+            break;
+        case COOLING_DEVICES:
+            thermal->getCoolingDevices([&ok](const auto& status, const auto&) {
+                ok = status.code == ThermalStatusCode::SUCCESS;
+            });
+            break;
+        default:
+            break;
+    }
+    return ok;
+}
+
+static int64_t percentile(const std::vector<int64_t>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    return sorted[std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()))];
+}
+
+static void report(const Run& run, Method method, std::vector<int64_t>* latencies,
+                   uint64_t failures) {
+    std::sort(latencies->begin(), latencies->end());
+    printf("%7d  %-6s  %-17s  %8zu  %9.0f  %7.1f  %7.1f  %7.1f  %8.1f  %6" PRIu64 "\n",
+           run.threads, run.cached ? "cached" : "live",
+           method < NUM_METHODS ? kMethodNames[method] : "all", latencies->size(),
+           latencies->size() * 1e9 / run.lengthNs, percentile(*latencies, .5) / 1e3,
+           percentile(*latencies, .9) / 1e3, percentile(*latencies, .99) / 1e3,
+           latencies->empty() ? 0. : latencies->back() / 1e3, failures);
+}
+
+// Every client picks its methods at random with the weights of the mix. At
+// a fixed rate, latency counts from when a call was due rather than from
+// when it was made, so a client held up by earlier calls does not hide the
+// queueing from the percentiles.
+static void runClients(Thermal* thermal, ThermalExt* ext, const Run& run) {
+    Threadpool pool(run.threads);
+    std::vector<std::vector<int64_t>> latencies(run.clients * NUM_METHODS);
+    std::vector<uint64_t> failures(run.clients * NUM_METHODS);
+    const int64_t startNs = monotonicNs();
+    const int64_t endNs = startNs + run.lengthNs;
+
+    std::vector<std::thread> clients;
+    for (int c = 0; c < run.clients; ++c) {
+        clients.emplace_back([&, c] {
+            std::mt19937 random(c + 1);
+            std::discrete_distribution<int> pick(run.mix.begin(), run.mix.end());
+            const int64_t intervalNs = run.rate > 0 ? 1e9 / run.rate : 0;
+            // Clients start spread over one interval.
+            int64_t dueNs = startNs + intervalNs * c / run.clients;
+            while (true) {
+                int64_t nowNs = monotonicNs();
+                if (intervalNs > 0 && dueNs > nowNs) {
+                    const int64_t sleepNs = dueNs - nowNs;
+                    const struct timespec ts = {static_cast<time_t>(sleepNs / 1000000000),
+                                                static_cast<long>(sleepNs % 1000000000)};
+                    nanosleep(&ts, nullptr);
+                    nowNs = dueNs;
+                } else if (intervalNs == 0) {
+                    dueNs = nowNs;
+                }
+                if (nowNs >= endNs) {
+                    break;
+                }
+                const Method method = static_cast<Method>(pick(random));
+                pool.enter();
+                const bool ok = call(thermal, ext, run, method);
+                pool.leave();
+                const size_t slot = c * NUM_METHODS + method;
+                latencies[slot].push_back(monotonicNs() - dueNs);
+                failures[slot] += !ok;
+                dueNs += intervalNs;
+            }
+        });
+    }
+    for (auto& client : clients) {
+        client.join();
+    }
+
+    std::vector<int64_t> all;
+    uint64_t allFailures = 0;
+    for (int m = 0; m < NUM_METHODS; ++m) {
+        std::vector<int64_t> merged;
+        uint64_t methodFailures = 0;
+        for (int c = 0; c < run.clients; ++c) {
+            const size_t slot = c * NUM_METHODS + m;
+            merged.insert(merged.end(), latencies[slot].begin(), latencies[slot].end());
+            methodFailures += failures[slot];
+        }
+        if (merged.empty()) {
+            continue;
+        }
+        all.insert(all.end(), merged.begin(), merged.end());
+        allFailures += methodFailures;
+        report(run, static_cast<Method>(m), &merged, methodFailures);
+    }
+    report(run, NUM_METHODS, &all, allFailures);
+}
+
+// Runs the HAL in process, as the binderized service would configure it,
+// on a fake sysfs tree and drives it from several client threads at once,
+// once for every threadpool size and caching mode asked for.
+int main(int argc, char **argv) {
+    int zones = 8;
+    int cpus = 8;
+    Run run = {};
+    run.clients = 4;
+    run.lengthNs = 5000000000LL;
+    run.mix = {6, 3, 1};
+    std::vector<int> threads = {1, 2, 4};
+    std::vector<bool> modes = {false, true};
+    int opt;
+    while ((opt = getopt(argc, argv, "z:n:k:d:m:q:t:c:")) != -1) {
+        switch (opt) {
+            case 'z':
+                zones = atoi(optarg);
+                break;
+            case 'n':
+                cpus = atoi(optarg);
+                break;
+            case 'k':
+                run.clients = atoi(optarg);
+                break;
+            case 'd':
+                run.lengthNs = atof(optarg) * 1e9;
+                break;
+            case 'm':
+                if (!parseList(optarg, &run.mix) || run.mix.size() != NUM_METHODS) {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'q':
+                run.rate = atof(optarg);
+                break;
+            case 't':
+                if (!parseList(optarg, &threads)) {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'c':
+                modes.clear();
+                for (const auto& mode : ::android::base::Split(optarg, ",")) {
+                    if (mode != "live" && mode != "cached") {
+                        usage(argv[0]);
+                        return 1;
+                    }
+                    modes.push_back(mode == "cached");
+                }
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (zones <= 0 || cpus <= 0 || run.clients <= 0 || run.lengthNs <= 0 ||
+        std::count(run.mix.begin(), run.mix.end(), 0) == NUM_METHODS ||
+        std::count(threads.begin(), threads.end(), 0) > 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    FakeSysfs sysfs;
+    std::vector<hidl_string> names;
+    for (int z = 0; z < zones; ++z) {
+        names.push_back("sensor-thermal" + std::to_string(z + 1));
+        if (!sysfs.addZone(z, names.back(), 45.f + z)) {
+            fprintf(stderr, "cannot create the fake tree in %s\n", sysfs.root());
+            return 1;
+        }
+    }
+    run.filter.names = names;
+    run.filter.cached = true;
+    if (!sysfs.addCpus(cpus)) {
+        fprintf(stderr, "cannot create the fake tree in %s\n", sysfs.root());
+        return 1;
+    }
+    ThermalWatcher::setRootDir(sysfs.root());
+    const sp<Thermal> thermal = new Thermal();
+    const sp<ThermalExt> ext = new ThermalExt(thermal);
+    // The cached mode needs a first sampling round.
+    sleep(1);
+
+    printf("%d clients, %d zones, %d CPUs, ", run.clients, zones, cpus);
+    if (run.rate > 0) {
+        printf("%g calls/s each\n", run.rate);
+    } else {
+        printf("back to back\n");
+    }
+    printf("threads  mode    method                calls    calls/s   p50 us   p90 us"
+           "   p99 us    max us  failed\n");
+    for (int size : threads) {
+        for (bool cached : modes) {
+            run.threads = size;
+            run.cached = cached;
+            runClients(thermal.get(), ext.get(), run);
+        }
+    }
+    return 0;
+}
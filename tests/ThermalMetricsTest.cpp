@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <math.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include <android-base/file.h>
+#include <android-base/strings.h>
+#include <android-base/unique_fd.h>
+#include <gtest/gtest.h>
+
+#include "ThermalMetrics.h"
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+using ::android::base::unique_fd;
+
+// One exporter serving a snapshot of two zones and a fan, with two CPUs, on
+// a socket in a temporary directory; it lives for the whole suite since its
+// thread never returns from accept().
+class ThermalMetricsTest : public ::testing::Test {
+  protected:
+    static void SetUpTestSuite() {
+        sDir = new TemporaryDir();
+        sSnapshot = new ThermalSnapshot();
+        ASSERT_TRUE(sSnapshot->open(std::string(sDir->path) + "/snapshot",
+                                    {"cpu-thermal", "gpu-thermal"}));
+        const float temperatures[] = {45.5f, NAN};
+        const int64_t readNs[] = {1000000000, 0};
+        const uint8_t levels[] = {static_cast<uint8_t>(SeverityLevel::SEVERE), 0};
+        sSnapshot->update(temperatures, readNs, levels, SeverityLevel::SEVERE, 1000000000);
+        const int fan = sSnapshot->addActuator("fan");
+        ASSERT_GE(fan, 0);
+        sSnapshot->updateActuator(fan, 2, 1000000000);
+
+        sSocketPath = std::string(sDir->path) + "/metrics";
+        unique_fd server(socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0));
+        ASSERT_GE(server, 0);
+        struct sockaddr_un addr = {};
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, sSocketPath.c_str(), sizeof(addr.sun_path) - 1);
+        ASSERT_EQ(0, bind(server, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)));
+
+        sMetrics = new ThermalMetrics(*sSnapshot);
+        sMetrics->recordCall(ThermalMetrics::GET_TEMPERATURES, 30000);
+        sMetrics->recordCall(ThermalMetrics::GET_TEMPERATURES, 2000000);
+        ASSERT_TRUE(sMetrics->startServing(
+                server.release(),
+                [](std::vector<V1_0::CpuUsage>* usages) {
+                    usages->push_back({"cpu0", 100, 400, true});
+                    usages->push_back({"cpu1", 0, 300, false});
+                    return true;
+                },
+                [](std::vector<CpuIdleTotal>*, std::vector<float>*) { return false; }));
+    }
+
+    // Connects like a local client, sends request if any and reads until
+    // the exporter closes the connection.
+    static std::string scrape(const std::string& request) {
+        unique_fd client(socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0));
+        struct sockaddr_un addr = {};
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, sSocketPath.c_str(), sizeof(addr.sun_path) - 1);
+        if (client < 0 ||
+            connect(client, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0 ||
+            (!request.empty() && !::android::base::WriteStringToFd(request, client))) {
+            return "";
+        }
+        std::string response;
+        ::android::base::ReadFdToString(client, &response);
+        return response;
+    }
+
+    static TemporaryDir *sDir;
+    static ThermalSnapshot *sSnapshot;
+    static std::string sSocketPath;
+    static sp<ThermalMetrics> sMetrics;
+};
+
+TemporaryDir *ThermalMetricsTest::sDir;
+ThermalSnapshot *ThermalMetricsTest::sSnapshot;
+std::string ThermalMetricsTest::sSocketPath;
+sp<ThermalMetrics> ThermalMetricsTest::sMetrics;
+
+static bool contains(const std::string& text, const std::string& line) {
+    return text.find("\n" + line + "\n") != std::string::npos;
+}
+
+TEST_F(ThermalMetricsTest, PlainClientGetsTheExposition) {
+    const std::string text = "\n" + scrape("");
+    EXPECT_TRUE(contains(text, "thermal_zone_temperature_celsius{zone=\"cpu-thermal\"} 45.5"));
+    EXPECT_TRUE(contains(text, "thermal_zone_temperature_celsius{zone=\"gpu-thermal\"} NaN"));
+    EXPECT_TRUE(contains(text, "thermal_zone_severity_level{zone=\"cpu-thermal\"} 3"));
+    EXPECT_TRUE(contains(text, "thermal_device_severity_level 3"));
+    EXPECT_TRUE(contains(text, "thermal_cooling_state{device=\"fan\"} 2"));
+    EXPECT_TRUE(contains(text, "thermal_cpu_active_jiffies_total{cpu=\"cpu0\"} 100"));
+    EXPECT_TRUE(contains(text, "thermal_cpu_jiffies_total{cpu=\"cpu1\"} 300"));
+    EXPECT_TRUE(contains(text, "thermal_cpu_online{cpu=\"cpu1\"} 0"));
+    EXPECT_TRUE(text.find("thermal_cpu_idle") == std::string::npos);
+}
+
+TEST_F(ThermalMetricsTest, HistogramsAreCumulative) {
+    const std::string text = "\n" + scrape("");
+    EXPECT_TRUE(contains(text, "thermal_hal_call_duration_seconds_bucket"
+                               "{method=\"getTemperatures\",le=\"5e-05\"} 1"));
+    EXPECT_TRUE(contains(text, "thermal_hal_call_duration_seconds_bucket"
+                               "{method=\"getTemperatures\",le=\"0.001\"} 1"));
+    EXPECT_TRUE(contains(text, "thermal_hal_call_duration_seconds_bucket"
+                               "{method=\"getTemperatures\",le=\"0.0025\"} 2"));
+    EXPECT_TRUE(contains(text, "thermal_hal_call_duration_seconds_bucket"
+                               "{method=\"getTemperatures\",le=\"+Inf\"} 2"));
+    EXPECT_TRUE(contains(text, "thermal_hal_call_duration_seconds_sum"
+                               "{method=\"getTemperatures\"} 0.00203"));
+    EXPECT_TRUE(contains(text, "thermal_hal_call_duration_seconds_count"
+                               "{method=\"getCpuUsages\"} 0"));
+}
+
+TEST_F(ThermalMetricsTest, HttpClientGetsAResponse) {
+    const std::string response = scrape("GET /metrics HTTP/1.0\r\n\r\n");
+    ASSERT_TRUE(::android::base::StartsWith(response, "HTTP/1.0 200 OK\r\n"));
+    const size_t bodyStart = response.find("\r\n\r\n");
+    ASSERT_NE(std::string::npos, bodyStart);
+    const std::string body = response.substr(bodyStart + 4);
+    EXPECT_NE(std::string::npos,
+              response.find("Content-Length: " + std::to_string(body.size()) + "\r\n"));
+    EXPECT_TRUE(::android::base::StartsWith(body, "# HELP "));
+}
+
+TEST_F(ThermalMetricsTest, StalledClientDoesNotStopTheExporter) {
+    unique_fd stalled(socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0));
+    struct sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, sSocketPath.c_str(), sizeof(addr.sun_path) - 1);
+    ASSERT_EQ(0, connect(stalled, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)));
+    // Connected and never read from, then dropped without a word.
+    unique_fd dropped(socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0));
+    ASSERT_EQ(0, connect(dropped, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)));
+    dropped.reset();
+    EXPECT_TRUE(::android::base::StartsWith(scrape(""), "# HELP "));
+}
+
+// Every line is a comment, or a sample as the text format 0.0.4 has it, and
+// every metric is declared before its samples.
+TEST_F(ThermalMetricsTest, ExpositionIsWellFormed) {
+    const std::regex sample(
+            "([a-zA-Z_:][a-zA-Z0-9_:]*)(\\{[a-zA-Z_][a-zA-Z0-9_]*=\"[^\"\\\\\\n]*\""
+            "(,[a-zA-Z_][a-zA-Z0-9_]*=\"[^\"\\\\\\n]*\")*\\})? "
+            "(NaN|[+-]Inf|[-+]?[0-9.]+(e[-+]?[0-9]+)?)");
+    const std::regex type("# TYPE ([a-zA-Z_:][a-zA-Z0-9_:]*) (counter|gauge|histogram)");
+    std::vector<std::string> declared;
+    const std::string text = scrape("");
+    ASSERT_FALSE(text.empty());
+    ASSERT_EQ('\n', text.back());
+    for (const auto& line : ::android::base::Split(text.substr(0, text.size() - 1), "\n")) {
+        std::smatch match;
+        if (std::regex_match(line, match, type)) {
+            declared.push_back(match[1]);
+        } else if (!::android::base::StartsWith(line, "# HELP ")) {
+            ASSERT_TRUE(std::regex_match(line, match, sample)) << line;
+            std::string name = match[1];
+            for (const char *suffix : {"_bucket", "_sum", "_count"}) {
+                if (::android::base::EndsWith(name, suffix) &&
+                    std::find(declared.begin(), declared.end(), name) == declared.end()) {
+                    name = name.substr(0, name.size() - strlen(suffix));
+                }
+            }
+            EXPECT_FALSE(std::find(declared.begin(), declared.end(), name) == declared.end())
+                    << line;
+        }
+    }
+}
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
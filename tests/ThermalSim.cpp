@@ -0,0 +1,444 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <android-base/strings.h>
+#include <android-base/unique_fd.h>
+
+#include "BoardProfile.h"
+#include "FakeSysfs.h"
+#include "ThermalConfig.h"
+#include "ThermalTrace.h"
+#include "ThermalWatcher.h"
+
+#define STEP_NS                 1000000LL
+#define AMBIENT                 25.f
+// Thermal resistance to ambient (K/W), between neighbouring zones (K/W),
+// and heat capacity (J/K) of every zone.
+#define R_AMBIENT               10.f
+#define R_COUPLING              8.f
+#define CAPACITY                2.f
+#define DEFAULT_PERIOD_MS       1000
+#define WINDOW_TRIPS            2
+#define BATTERY_SUPPLY          "battery"
+#define CHARGE_LIMIT_UA         2000000
+
+using namespace android::hardware::thermal::V1_1::renesas;
+
+// Fraction of the demanded frequency left at each cooling state, which
+// the platform sets to the severity level the HAL reports. Heat input
+// scales with it, and so does the performance delivered.
+static const float kLevelCaps[kNumSeverityLevels] = {1.f, .9f, .75f, .5f, .3f, .1f};
+
+struct Phase {
+    double seconds;
+    float watts;
+};
+
+// A node of the model, seen by the HAL as a thermal zone with a cooling
+// device, or as the battery's power supply.
+struct SimZone {
+    std::string name;
+    // Share of the demanded power dissipated in this zone; the battery
+    // dissipates the charging power instead.
+    float share = 0.f;
+    bool battery = false;
+    float temperature = AMBIENT;
+    float peak = AMBIENT;
+    // Last value written to the temp file, in the unit of the file.
+    long written = 0;
+    // cur_state of the cooling device, or the battery's charge limit.
+    ::android::base::unique_fd actuatorFd;
+    long actuator = 0;
+    // Guarded by the lock of the run: the level the HAL last reported,
+    // and the start of each crossing above it not reported yet.
+    SeverityLevel reported = SeverityLevel::NONE;
+    int64_t crossedNs[kNumSeverityLevels] = {};
+};
+
+static int64_t monotonicNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static void sleepUntil(int64_t ns) {
+    const int64_t waitNs = ns - monotonicNs();
+    if (waitNs > 0) {
+        const struct timespec ts = {static_cast<time_t>(waitNs / 1000000000),
+                                    static_cast<long>(waitNs % 1000000000)};
+        nanosleep(&ts, nullptr);
+    }
+}
+
+static void usage(const char *name) {
+    fprintf(stderr,
+            "usage: %s [-c config] [-s speed] [-m mode] [-p period] [-l profile] [-b watts]\n"
+            "          [-o trace] zone:share...\n"
+            "  -c  thresholds, in the format of thermal-renesas.conf\n"
+            "  -s  speed of the simulated clock relative to real time\n"
+            "  -m  window to wake the HAL on trip points, poll to have it poll\n"
+            "  -p  polling period in simulated ms, 0 for the configured one\n"
+            "  -l  load profile as seconds:watts steps, e.g. 30:2,60:15,30:4\n"
+            "  -b  heat of charging the battery at its full current, 0 for no battery\n"
+            "  -o  record the temperatures written for thermal-replay\n"
+            "zone:share dissipates share of the load in a zone of that type\n",
+            name);
+}
+
+static bool parseProfile(const std::string& text, std::vector<Phase>* profile) {
+    for (const auto& step : ::android::base::Split(text, ",")) {
+        Phase phase;
+        if (sscanf(step.c_str(), "%lf:%f", &phase.seconds, &phase.watts) != 2 ||
+            phase.seconds <= 0) {
+            return false;
+        }
+        profile->push_back(phase);
+    }
+    return !profile->empty();
+}
+
+static long readState(int fd) {
+    char buf[32];
+    const ssize_t len = TEMP_FAILURE_RETRY(pread(fd, buf, sizeof(buf) - 1, 0));
+    if (len <= 0) {
+        return -1;
+    }
+    buf[len] = '\0';
+    return atol(buf);
+}
+
+// Runs a lumped RC model of the SoC against the HAL's watcher, closing the
+// loop through a fake sysfs tree. Each zone is one node coupled to ambient
+// and to its neighbours, with the battery last. Every simulated
+// millisecond the model reads back the cooling state of each zone and the
+// battery's charge limit, which set the heat it dissipates, and writes the
+// temperatures; for zones with trip windows it plays the kernel's part and
+// sends the uevents. The charge limit is the HAL's own write. The cooling
+// states are the platform's answer to the levels the HAL reports, which the
+// simulator gives in the HAL's callback, as a user space governor would.
+// The run is scored on overshoot, the performance delivered and the delay
+// between a threshold being crossed and the HAL reporting it.
+int main(int argc, char **argv) {
+    std::string configPath = "thermal-renesas.conf";
+    std::string tracePath;
+    double speed = 10;
+    bool window = true;
+    uint32_t periodMs = 0;
+    float chargeWatts = 1.5f;
+    std::vector<Phase> profile = {{30, 2}, {60, 15}, {30, 4}};
+    int opt;
+    while ((opt = getopt(argc, argv, "c:s:m:p:l:b:o:")) != -1) {
+        switch (opt) {
+            case 'c':
+                configPath = optarg;
+                break;
+            case 's':
+                speed = atof(optarg);
+                break;
+            case 'm':
+                if (strcmp(optarg, "window") && strcmp(optarg, "poll")) {
+                    usage(argv[0]);
+                    return 1;
+                }
+                window = !strcmp(optarg, "window");
+                break;
+            case 'p':
+                periodMs = atoi(optarg);
+                break;
+            case 'l':
+                profile.clear();
+                if (!parseProfile(optarg, &profile)) {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'b':
+                chargeWatts = atof(optarg);
+                break;
+            case 'o':
+                tracePath = optarg;
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (speed <= 0 || chargeWatts < 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    std::vector<SimZone> zones;
+    for (int i = optind; i < argc; ++i) {
+        const auto fields = ::android::base::Split(argv[i], ":");
+        zones.emplace_back();
+        zones.back().name = fields[0];
+        zones.back().share = fields.size() > 1 ? atof(fields[1].c_str()) : 1.f;
+    }
+    if (zones.empty()) {
+        zones.resize(2);
+        zones[0].name = "cpu-thermal";
+        zones[0].share = .6f;
+        zones[1].name = "gpu-thermal";
+        zones[1].share = .4f;
+    }
+    if (chargeWatts > 0) {
+        zones.emplace_back();
+        zones.back().name = BATTERY_SUPPLY;
+        zones.back().battery = true;
+    }
+
+    ZoneConfig defaults;
+    defaults.hot.fill(NAN);
+    defaults.cold.fill(NAN);
+    ThermalConfig config(defaults);
+    if (!config.load(configPath)) {
+        fprintf(stderr, "cannot read %s\n", configPath.c_str());
+        return 1;
+    }
+    ThermalTraceWriter trace;
+    if (!tracePath.empty() && !trace.open(tracePath)) {
+        fprintf(stderr, "cannot write %s\n", tracePath.c_str());
+        return 1;
+    }
+
+    // Every zone gets a cooling device; with trip windows, both window
+    // trips start out of the way and the watcher moves them.
+    FakeSysfs sysfs;
+    ThermalConfig scaled = config;
+    std::vector<std::string> actuatorNames, actuatorDirs;
+    for (size_t z = 0; z < zones.size(); ++z) {
+        SimZone& zone = zones[z];
+        std::string state;
+        if (zone.battery) {
+            if (!sysfs.addSupply(zone.name, "Battery", AMBIENT, CHARGE_LIMIT_UA)) {
+                break;
+            }
+            state = FakeSysfs::supplyDir(zone.name) + "/constant_charge_current_max";
+            zone.written = lroundf(AMBIENT * 10);
+            zone.actuator = CHARGE_LIMIT_UA;
+        } else {
+            if (!sysfs.addZone(z, zone.name, AMBIENT) ||
+                !sysfs.addCoolingDevice(z, "cap-" + zone.name, kNumSeverityLevels - 1) ||
+                (window && (!sysfs.addTrip(z, 0, "passive", 150.f, 0.f) ||
+                            !sysfs.addTrip(z, 1, "passive", 150.f, 0.f) ||
+                            !sysfs.addTrip(z, 2, "critical", 150.f, 0.f)))) {
+                break;
+            }
+            actuatorNames.push_back("cap-" + zone.name);
+            actuatorDirs.push_back(FakeSysfs::coolingDeviceDir(z));
+            state = actuatorDirs.back() + "/cur_state";
+            zone.written = lroundf(AMBIENT * 1000);
+        }
+        zone.actuatorFd.reset(open((sysfs.root() + state).c_str(), O_RDONLY | O_CLOEXEC));
+        if (zone.actuatorFd < 0) {
+            break;
+        }
+        ZoneConfig zoneConfig = config.zone(zone.name);
+        zoneConfig.periodMs = std::max<uint32_t>(1, (periodMs > 0 ? periodMs :
+                zoneConfig.periodMs > 0 ? zoneConfig.periodMs : DEFAULT_PERIOD_MS) / speed);
+        scaled.set(zone.name, zoneConfig);
+        if (trace.isOpen()) {
+            trace.zoneAdded(0, z, zone.name);
+            if (!zone.battery) {
+                trace.actuatorAdded(0, z, actuatorNames.back());
+            }
+        }
+    }
+    if (zones.back().actuatorFd < 0) {
+        fprintf(stderr, "cannot create the fake tree in %s\n", sysfs.root());
+        return 1;
+    }
+    std::vector<BoardActuator> actuators;
+    for (size_t a = 0; a < actuatorNames.size(); ++a) {
+        actuators.push_back({actuatorNames[a].c_str(), actuatorDirs[a].c_str()});
+    }
+
+    std::mutex lock;
+    std::atomic<int64_t> simNowNs(0);
+    int64_t latencySumNs = 0, latencyMaxNs = 0;
+    uint64_t latencyCount = 0;
+    ThermalSnapshot snapshot;
+    ThermalJournal journal;
+    ThermalTimeline timeline;
+    ThermalWatcher::setRootDir(sysfs.root());
+    const ::android::sp<ThermalWatcher> watcher = new ThermalWatcher(
+            scaled, snapshot, journal, timeline,
+            [&](const std::string& name, float temperature, SeverityLevel from,
+                SeverityLevel to) {
+                const int64_t nowNs = simNowNs.load();
+                std::lock_guard<std::mutex> _lock(lock);
+                const auto it = std::find_if(zones.begin(), zones.end(),
+                                             [&name](const SimZone& z) { return z.name == name; });
+                if (it == zones.end()) {
+                    return;
+                }
+                printf("%9.3f s  %s %.1f C %s -> %s\n", nowNs / 1e9, name.c_str(), temperature,
+                       toString(from), toString(to));
+                for (size_t l = static_cast<size_t>(from) + 1; l <= static_cast<size_t>(to);
+                     ++l) {
+                    int64_t& crossedNs = it->crossedNs[l];
+                    if (crossedNs != 0) {
+                        latencySumNs += nowNs - crossedNs;
+                        latencyMaxNs = std::max(latencyMaxNs, nowNs - crossedNs);
+                        ++latencyCount;
+                        crossedNs = 0;
+                    }
+                }
+                it->reported = to;
+                if (!it->battery) {
+                    sysfs.setCoolingState(it - zones.begin(), static_cast<int>(to));
+                }
+            });
+    watcher->useInjectedUevents();
+    watcher->setActuators(actuators.data(), actuators.size());
+    if (!watcher->discover(window) ||
+        !watcher->startWatching(std::string(sysfs.root()) + "/snapshot")) {
+        fprintf(stderr, "cannot start the watcher on %s\n", sysfs.root());
+        return 1;
+    }
+    // The first round reads every zone and programs the windows.
+    while (watcher->stats().reads < zones.size()) {
+        sleepUntil(monotonicNs() + 1000000);
+    }
+    const ThermalWatcher::Stats before = watcher->stats();
+
+    std::vector<float> power(zones.size());
+    double demanded = 0, delivered = 0, charged = 0;
+    int64_t nowNs = 0;
+    const int64_t startNs = monotonicNs();
+    for (const auto& phase : profile) {
+        const int64_t endNs = nowNs + static_cast<int64_t>(phase.seconds * 1e9);
+        for (; nowNs < endNs; nowNs += STEP_NS) {
+            sleepUntil(startNs + nowNs / speed);
+            simNowNs.store(nowNs);
+
+            // Heat flow over one step, with the caps the tree holds now.
+            for (size_t z = 0; z < zones.size(); ++z) {
+                SimZone& zone = zones[z];
+                const long state = readState(zone.actuatorFd);
+                if (state >= 0 && state != zone.actuator) {
+                    zone.actuator = state;
+                    if (trace.isOpen() && !zone.battery) {
+                        trace.actuatorRead(nowNs, z, state);
+                    }
+                }
+                if (zone.battery) {
+                    const float current = static_cast<float>(zone.actuator) / CHARGE_LIMIT_UA;
+                    power[z] = chargeWatts * current * current;
+                    charged += current;
+                } else {
+                    const size_t level = std::min<long>(std::max(zone.actuator, 0L),
+                                                        kNumSeverityLevels - 1);
+                    power[z] = phase.watts * zone.share * kLevelCaps[level];
+                    demanded += phase.watts * zone.share;
+                    delivered += power[z];
+                }
+            }
+            std::lock_guard<std::mutex> _lock(lock);
+            for (size_t z = 0; z < zones.size(); ++z) {
+                SimZone& zone = zones[z];
+                float flow = power[z] - (zone.temperature - AMBIENT) / R_AMBIENT;
+                if (z > 0) {
+                    flow -= (zone.temperature - zones[z - 1].temperature) / R_COUPLING;
+                }
+                if (z + 1 < zones.size()) {
+                    flow -= (zone.temperature - zones[z + 1].temperature) / R_COUPLING;
+                }
+                zone.temperature += flow * (STEP_NS / 1e9f) / CAPACITY;
+                zone.peak = std::max(zone.peak, zone.temperature);
+
+                // Sensors report whole millidegrees, fuel gauges tenths,
+                // and the gauge sends a uevent with each new reading.
+                const long previous = zone.written;
+                if (zone.battery) {
+                    zone.written = lroundf(zone.temperature * 10);
+                    if (zone.written != previous) {
+                        sysfs.setSupplyTemperature(zone.name, zone.temperature);
+                        watcher->injectUevent(FakeSysfs::changeUevent(
+                                "/devices/platform/" + zone.name + "/power_supply/" + zone.name,
+                                "power_supply"));
+                    }
+                } else {
+                    zone.written = lroundf(zone.temperature * 1000);
+                    if (zone.written != previous) {
+                        sysfs.setTemperature(z, zone.temperature);
+                        if (window && sysfs.crossesTrip(z, WINDOW_TRIPS, previous, zone.written)) {
+                            watcher->injectUevent(FakeSysfs::changeUevent(
+                                    "/devices/virtual/thermal/thermal_zone" + std::to_string(z),
+                                    "thermal"));
+                        }
+                    }
+                }
+                if (trace.isOpen() && zone.written != previous) {
+                    trace.zoneRead(nowNs, z, zone.battery ? zone.written * 100 : zone.written);
+                }
+
+                // Note when the temperature the sensor reports first
+                // crosses a level the HAL has not reported yet.
+                const float sensed = zone.battery ? zone.written * .1f : zone.written * .001f;
+                const ZoneConfig& zoneConfig = config.zone(zone.name);
+                for (size_t l = static_cast<size_t>(zone.reported) + 1; l < kNumSeverityLevels;
+                     ++l) {
+                    if (zone.crossedNs[l] == 0 && sensed >= zoneConfig.hot[l]) {
+                        zone.crossedNs[l] = nowNs;
+                    } else if (sensed < zoneConfig.hot[l]) {
+                        zone.crossedNs[l] = 0;
+                    }
+                }
+            }
+        }
+        trace.flush();
+    }
+    const ThermalWatcher::Stats after = watcher->stats();
+    watcher->stopWatching();
+
+    std::lock_guard<std::mutex> _lock(lock);
+    printf("\n%.1f s simulated at %gx in %s mode, %" PRIu64 " wakeups, %" PRIu64 " reads\n",
+           nowNs / 1e9, speed, window ? "window" : "poll",
+           after.ueventWakeups + after.pollWakeups - before.ueventWakeups - before.pollWakeups,
+           after.reads - before.reads);
+    for (const auto& zone : zones) {
+        float first = NAN;
+        for (size_t l = 1; l < kNumSeverityLevels && isnan(first); ++l) {
+            first = config.zone(zone.name).hot[l];
+        }
+        printf("%s: peak %.1f C, overshoot %.1f C\n", zone.name.c_str(), zone.peak,
+               isnan(first) ? 0.f : std::max(0.f, zone.peak - first));
+    }
+    printf("performance delivered: %.1f%%\n", demanded > 0 ? 100 * delivered / demanded : 100);
+    if (chargeWatts > 0) {
+        printf("charge current delivered: %.1f%%\n", 100 * charged * STEP_NS / nowNs);
+    }
+    printf("notification latency: mean %.1f ms, max %.1f ms over %" PRIu64 " crossings\n",
+           latencyCount > 0 ? latencySumNs / 1e6 / latencyCount : 0, latencyMaxNs / 1e6,
+           latencyCount);
+    return 0;
+}
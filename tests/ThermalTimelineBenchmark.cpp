@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+
+#include <benchmark/benchmark.h>
+
+#include "ThermalTimeline.h"
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+static constexpr size_t kZones = 8;
+
+// The per-zone step of a sampling round as the watcher records it: the
+// reading, then the counter if the timeline is on. state.range(0) is -1 for
+// a round without any timeline, to compare with, then 0 for disabled and 1
+// for enabled. Disabled should come out at the baseline, give or take the
+// one branch per zone.
+static void BM_TimelineCounter(benchmark::State& state) {
+    ThermalTimeline timeline;
+    const bool present = state.range(0) >= 0;
+    timeline.setEnabled(state.range(0) > 0);
+    double value = 45.;
+    int64_t nowNs = 0;
+    for (auto _ : state) {
+        nowNs += 1000000;
+        for (size_t zone = 0; zone < kZones; ++zone) {
+            value += 0.001;
+            benchmark::DoNotOptimize(value);
+            if (present && timeline.enabled()) {
+                timeline.counter(ThermalTimeline::TEMPERATURE, zone, value, nowNs);
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * kZones);
+}
+BENCHMARK(BM_TimelineCounter)->Arg(-1)->Arg(0)->Arg(1);
+
+// A HAL call's slice, as taken around every entry point.
+static void BM_TimelineSlice(benchmark::State& state) {
+    ThermalTimeline timeline;
+    timeline.setEnabled(state.range(0) > 0);
+    int64_t nowNs = 0;
+    for (auto _ : state) {
+        nowNs += 1000;
+        benchmark::DoNotOptimize(nowNs);
+        if (timeline.enabled()) {
+            timeline.slice("getTemperatures", nowNs - 500, nowNs);
+        }
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_TimelineSlice)->Arg(0)->Arg(1);
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+
+#include <android-base/file.h>
+#include <gtest/gtest.h>
+
+#include "ThermalTrace.h"
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+TEST(ThermalTraceTest, RoundTrip) {
+    TemporaryDir dir;
+    const std::string path = std::string(dir.path) + "/trace";
+    ThermalTraceWriter writer;
+    ASSERT_TRUE(writer.open(path));
+    EXPECT_TRUE(writer.isOpen());
+    writer.zoneAdded(1, 0, "sensor-thermal1");
+    writer.zoneRead(2, 0, 45500);
+    writer.actuatorAdded(3, 1, "gpu-devfreq");
+    writer.actuatorRead(4, 1, 3);
+    writer.cpuRead(5, 2, 1000, 1500);
+    writer.flush();
+
+    ThermalTraceReader reader;
+    ASSERT_TRUE(reader.open(path));
+    ThermalTrace::Event event;
+    ASSERT_TRUE(reader.next(&event));
+    EXPECT_EQ(ThermalTrace::ZONE_ADDED, event.kind);
+    EXPECT_EQ("sensor-thermal1", event.name);
+    ASSERT_TRUE(reader.next(&event));
+    EXPECT_EQ(ThermalTrace::ZONE_READ, event.kind);
+    EXPECT_EQ(2, event.bootNs);
+    EXPECT_EQ(45500, event.value);
+    ASSERT_TRUE(reader.next(&event));
+    EXPECT_EQ(ThermalTrace::ACTUATOR_ADDED, event.kind);
+    EXPECT_EQ(1u, event.index);
+    EXPECT_EQ("gpu-devfreq", event.name);
+    ASSERT_TRUE(reader.next(&event));
+    EXPECT_EQ(ThermalTrace::ACTUATOR_READ, event.kind);
+    EXPECT_EQ(3, event.value);
+    ASSERT_TRUE(reader.next(&event));
+    EXPECT_EQ(ThermalTrace::CPU_READ, event.kind);
+    EXPECT_EQ(2u, event.index);
+    EXPECT_EQ(1000, event.value);
+    EXPECT_EQ(1500, event.total);
+    EXPECT_FALSE(reader.next(&event));
+
+    // Header, 24 bytes per record and the two names padded to 16 bytes.
+    std::string content;
+    ASSERT_TRUE(::android::base::ReadFileToString(path, &content));
+    EXPECT_EQ(8u + 5 * 24 + 2 * 16, content.size());
+}
+
+TEST(ThermalTraceTest, IdleJiffiesCarryPastTheRecordedBits) {
+    TemporaryDir dir;
+    const std::string path = std::string(dir.path) + "/trace";
+    ThermalTraceWriter writer;
+    ASSERT_TRUE(writer.open(path));
+    const uint64_t idle = 0xffffff00u;
+    writer.cpuRead(1, 0, 100, 100 + idle);
+    writer.cpuRead(2, 0, 200, 200 + idle + 0x200);
+    writer.flush();
+
+    ThermalTraceReader reader;
+    ASSERT_TRUE(reader.open(path));
+    ThermalTrace::Event first, second;
+    ASSERT_TRUE(reader.next(&first));
+    ASSERT_TRUE(reader.next(&second));
+    EXPECT_EQ(100 + 0x200, second.total - first.total);
+}
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
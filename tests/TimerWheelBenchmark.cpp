@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+
+#include <iterator>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "TimerWheel.h"
+
+// As the watcher sets up its wheel.
+#define WHEEL_TICK_NS           10000000LL
+#define WHEEL_SLOTS             512
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+// A mix like an R-Car board's: a few fast CPU die sensors, board and
+// battery sensors that move over seconds.
+static const int64_t kMixedPeriodsMs[] = {100, 250, 1000, 1000, 5000, 5000, 10000, 10000};
+
+// One iteration schedules state.range(0) zones for one second of simulated
+// time the way the watcher does: it sleeps until the next expiry, reads
+// the zones that fell due together in one round and arms them again.
+// state.range(1) picks the mixed periods, or every zone at the fastest of
+// them as with a single sampling rate. The counters are per simulated
+// second.
+static void BM_TimerWheelSchedule(benchmark::State& state) {
+    const size_t zones = state.range(0);
+    const bool mixed = state.range(1);
+    std::vector<int64_t> periodsNs(zones);
+    for (size_t i = 0; i < zones; ++i) {
+        periodsNs[i] = (mixed ? kMixedPeriodsMs[i % std::size(kMixedPeriodsMs)] :
+                                kMixedPeriodsMs[0]) * 1000000LL;
+    }
+    TimerWheel wheel(WHEEL_TICK_NS, WHEEL_SLOTS);
+    int64_t nowNs = 0;
+    wheel.start(nowNs);
+    for (size_t i = 0; i < zones; ++i) {
+        wheel.schedule(i, 0);
+    }
+
+    std::vector<size_t> expired;
+    uint64_t reads = 0, rounds = 0;
+    for (auto _ : state) {
+        const int64_t endNs = nowNs + 1000000000LL;
+        while (nowNs < endNs) {
+            nowNs += wheel.nextExpiryNs(nowNs);
+            expired.clear();
+            wheel.advance(nowNs, &expired);
+            for (size_t i : expired) {
+                wheel.schedule(i, periodsNs[i]);
+            }
+            reads += expired.size();
+            rounds += !expired.empty();
+        }
+    }
+    state.counters["reads/s"] = static_cast<double>(reads) / state.iterations();
+    state.counters["rounds/s"] = static_cast<double>(rounds) / state.iterations();
+}
+BENCHMARK(BM_TimerWheelSchedule)
+        ->ArgNames({"zones", "mixed"})
+        ->ArgsProduct({{128, 256, 1024}, {0, 1}});
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
@@ -0,0 +1,244 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include <android-base/unique_fd.h>
+#include <android/hardware/thermal/1.0/hwtypes.h>
+#include <benchmark/benchmark.h>
+#include <hidl/HidlBinderSupport.h>
+#include <hidl/HidlTransportSupport.h>
+#include <hwbinder/Parcel.h>
+
+#include "FakeSysfs.h"
+#include "Thermal.h"
+
+// Registered by the server process this benchmark forks; not declared in
+// any manifest, which TREBLE_TESTING_OVERRIDE allows on debuggable builds.
+#define BENCHMARK_INSTANCE      "renesas-transport-benchmark"
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+static constexpr int kZones = 8;
+static constexpr int kCpus = 8;
+
+// Both reach a passive Thermal on the same fake tree: the stub through
+// passthrough, the proxy through hwbinder to the server process.
+static sp<IThermal> sPassthrough;
+static sp<IThermal> sBinderized;
+static const FakeSysfs *sSysfs;
+
+static bool ok(const ThermalStatus& status) {
+    return status.code == V1_0::ThermalStatusCode::SUCCESS;
+}
+
+// The sensor reads alone, as getTemperatures() makes them.
+static void BM_SysfsRead(benchmark::State& state) {
+    std::vector<::android::base::unique_fd> fds;
+    for (int z = 0; z < kZones; ++z) {
+        const std::string path = std::string(sSysfs->root()) + FakeSysfs::zoneDir(z) + "/temp";
+        fds.emplace_back(open(path.c_str(), O_RDONLY | O_CLOEXEC));
+    }
+    char buf[16];
+    for (auto _ : state) {
+        for (const auto& fd : fds) {
+            benchmark::DoNotOptimize(pread(fd, buf, sizeof(buf), 0));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kZones);
+}
+BENCHMARK(BM_SysfsRead);
+
+// The reply of getTemperatures() written to a parcel and read back, the way
+// the generated stub and proxy do it, without the transport.
+static void BM_MarshalTemperatures(benchmark::State& state) {
+    hidl_vec<Temperature> temperatures;
+    temperatures.resize(kZones);
+    for (int z = 0; z < kZones; ++z) {
+        temperatures[z].type = V1_0::TemperatureType::CPU;
+        temperatures[z].name = "sensor-thermal" + std::to_string(z + 1);
+        temperatures[z].currentValue = 45.f + z;
+    }
+    for (auto _ : state) {
+        Parcel parcel;
+        size_t parent;
+        size_t child;
+        status_t err = parcel.writeBuffer(&temperatures, sizeof(temperatures), &parent);
+        err |= writeEmbeddedToParcel(temperatures, &parcel, parent, 0, &child);
+        for (size_t i = 0; i < temperatures.size(); ++i) {
+            err |= V1_0::writeEmbeddedToParcel(temperatures[i], &parcel, child,
+                                               i * sizeof(Temperature));
+        }
+
+        parcel.setDataPosition(0);
+        const hidl_vec<Temperature> *out;
+        err |= parcel.readBuffer(sizeof(*out), &parent, reinterpret_cast<const void **>(&out));
+        err |= readEmbeddedFromParcel(*out, parcel, parent, 0, &child);
+        for (size_t i = 0; err == OK && i < out->size(); ++i) {
+            err |= V1_0::readEmbeddedFromParcel((*out)[i], parcel, child,
+                                                i * sizeof(Temperature));
+        }
+        if (err != OK) {
+            state.SkipWithError("marshalling failed");
+            return;
+        }
+        benchmark::DoNotOptimize(out);
+    }
+}
+BENCHMARK(BM_MarshalTemperatures);
+
+static void BM_MarshalCpuUsages(benchmark::State& state) {
+    hidl_vec<CpuUsage> usages;
+    usages.resize(kCpus);
+    for (int cpu = 0; cpu < kCpus; ++cpu) {
+        usages[cpu] = {"cpu" + std::to_string(cpu), 150, 1150, true};
+    }
+    for (auto _ : state) {
+        Parcel parcel;
+        size_t parent;
+        size_t child;
+        status_t err = parcel.writeBuffer(&usages, sizeof(usages), &parent);
+        err |= writeEmbeddedToParcel(usages, &parcel, parent, 0, &child);
+        for (size_t i = 0; i < usages.size(); ++i) {
+            err |= V1_0::writeEmbeddedToParcel(usages[i], &parcel, child, i * sizeof(CpuUsage));
+        }
+
+        parcel.setDataPosition(0);
+        const hidl_vec<CpuUsage> *out;
+        err |= parcel.readBuffer(sizeof(*out), &parent, reinterpret_cast<const void **>(&out));
+        err |= readEmbeddedFromParcel(*out, parcel, parent, 0, &child);
+        for (size_t i = 0; err == OK && i < out->size(); ++i) {
+            err |= V1_0::readEmbeddedFromParcel((*out)[i], parcel, child, i * sizeof(CpuUsage));
+        }
+        if (err != OK) {
+            state.SkipWithError("marshalling failed");
+            return;
+        }
+        benchmark::DoNotOptimize(out);
+    }
+}
+BENCHMARK(BM_MarshalCpuUsages);
+
+// state.range(0) is 0 in process and 1 over hwbinder.
+static void BM_GetTemperatures(benchmark::State& state) {
+    const sp<IThermal>& thermal = state.range(0) ? sBinderized : sPassthrough;
+    if (thermal == nullptr) {
+        state.SkipWithError("no HAL");
+        return;
+    }
+    for (auto _ : state) {
+        bool success = false;
+        thermal->getTemperatures([&success](const auto& status, const auto& temperatures) {
+            success = ok(status) && temperatures.size() == kZones;
+        });
+        if (!success) {
+            state.SkipWithError("getTemperatures failed");
+            return;
+        }
+    }
+}
+BENCHMARK(BM_GetTemperatures)->ArgName("binderized")->Arg(0)->Arg(1);
+
+static void BM_GetCpuUsages(benchmark::State& state) {
+    const sp<IThermal>& thermal = state.range(0) ? sBinderized : sPassthrough;
+    if (thermal == nullptr) {
+        state.SkipWithError("no HAL");
+        return;
+    }
+    for (auto _ : state) {
+        bool success = false;
+        thermal->getCpuUsages([&success](const auto& status, const auto& usages) {
+            success = ok(status) && usages.size() == kCpus;
+        });
+        if (!success) {
+            state.SkipWithError("getCpuUsages failed");
+            return;
+        }
+    }
+}
+BENCHMARK(BM_GetCpuUsages)->ArgName("binderized")->Arg(0)->Arg(1);
+
+// Serves a passive Thermal on the fake tree until killed.
+static void serve(const char *root) {
+    ThermalWatcher::setRootDir(root);
+    configureRpcThreadpool(1, true);
+    sp<Thermal> thermal = new Thermal(true);
+    if (thermal->registerAsService(BENCHMARK_INSTANCE) != OK) {
+        _exit(1);
+    }
+    joinRpcThreadpool();
+    _exit(0);
+}
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android
+
+using namespace android::hardware::thermal::V1_1::renesas;
+
+// Splits a HAL call into its costs: BM_SysfsRead is the I/O,
+// BM_Marshal* the parcel work of the reply, and what the binderized call
+// takes over the in-process one beyond that is the transport.
+int main(int argc, char **argv) {
+    setenv("TREBLE_TESTING_OVERRIDE", "true", 1);
+    FakeSysfs sysfs;
+    for (int z = 0; z < kZones; ++z) {
+        if (!sysfs.addZone(z, "sensor-thermal" + std::to_string(z + 1), 45.f + z)) {
+            fprintf(stderr, "cannot create the fake tree in %s\n", sysfs.root());
+            return 1;
+        }
+    }
+    if (!sysfs.addCpus(kCpus)) {
+        fprintf(stderr, "cannot create the fake tree in %s\n", sysfs.root());
+        return 1;
+    }
+    sSysfs = &sysfs;
+
+    // Forked before this process starts any thread of its own.
+    const pid_t server = fork();
+    if (server == 0) {
+        serve(sysfs.root());
+    }
+    sBinderized = IThermal::getService(BENCHMARK_INSTANCE);
+    // The implementation library gets the tree through the instance name,
+    // see HIDL_FETCH_IThermal().
+    sPassthrough = IThermal::getService(sysfs.root(), true /* getStub */);
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+
+    sBinderized.clear();
+    sPassthrough.clear();
+    if (server > 0) {
+        kill(server, SIGKILL);
+        waitpid(server, nullptr, 0);
+    }
+    return 0;
+}
@@ -0,0 +1,417 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <android-base/strings.h>
+
+#include "FakeSysfs.h"
+#include "SeverityEngine.h"
+#include "ThermalConfig.h"
+#include "ThermalTrace.h"
+#include "ThermalWatcher.h"
+
+#define SYNTHETIC_STEP_NS       100000000LL
+#define DEFAULT_PERIOD_MS       1000
+#define WINDOW_TRIPS            2
+
+using namespace android::hardware::thermal::V1_1::renesas;
+
+// Temperatures to play, in the order of the recording.
+struct Profile {
+    struct Sample {
+        int64_t ns;
+        size_t zone;
+        float temperature;
+    };
+    std::vector<std::string> names;
+    std::vector<Sample> samples;
+    int64_t lengthNs = 0;
+};
+
+struct Result {
+    ThermalWatcher::Stats stats;
+    // Reference transitions the watcher reported, and how long after the
+    // temperature was written, on the clock of the recording.
+    std::vector<int64_t> latenciesNs;
+    uint64_t transitions = 0;
+    // Reference transitions the watcher never reported, mostly excursions
+    // over a threshold that ended between two polls.
+    uint64_t missed = 0;
+};
+
+static int64_t monotonicNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static void sleepUntil(int64_t ns) {
+    const int64_t waitNs = ns - monotonicNs();
+    if (waitNs > 0) {
+        const struct timespec ts = {static_cast<time_t>(waitNs / 1000000000),
+                                    static_cast<long>(waitNs % 1000000000)};
+        nanosleep(&ts, nullptr);
+    }
+}
+
+static void usage(const char *name) {
+    fprintf(stderr,
+            "usage: %s [-c config] [-s speed] [-p period] [-z zones] [-d seconds] [-m modes]\n"
+            "          [trace]\n"
+            "  -c  thresholds, in the format of thermal-renesas.conf\n"
+            "  -s  playback speed relative to the recording\n"
+            "  -p  polling period in ms on the clock of the recording, 0 for the\n"
+            "      configured one\n"
+            "  -z  zones of the synthetic profile played without a trace\n"
+            "  -d  length of the synthetic profile\n"
+            "  -m  modes to run with: window sleeps until the trips of a zone are\n"
+            "      crossed, poll reads every zone at the polling period\n",
+            name);
+}
+
+// Every zone idles around 45 C with some noise and now and then heats up
+// to a peak, stays there for a while and cools down again. The short
+// excursions over a threshold are the ones polling can miss.
+static Profile synthesize(size_t zones, int64_t lengthNs) {
+    Profile profile;
+    profile.lengthNs = lengthNs;
+    const float stepS = SYNTHETIC_STEP_NS / 1e9f;
+    for (size_t z = 0; z < zones; ++z) {
+        profile.names.push_back("sensor-thermal" + std::to_string(z + 1));
+    }
+    for (size_t z = 0; z < zones; ++z) {
+        std::mt19937 random(z + 1);
+        std::normal_distribution<float> noise(0.f, .2f);
+        std::uniform_real_distribution<float> uniform(0.f, 1.f);
+        enum { IDLE, RISE, HOLD, FALL } phase = IDLE;
+        float temperature = 45.f, peak = 0.f, rate = 0.f;
+        int64_t holdNs = 0;
+        for (int64_t ns = 0; ns < lengthNs; ns += SYNTHETIC_STEP_NS) {
+            switch (phase) {
+                case IDLE:
+                    temperature += (45.f - temperature) * .05f + noise(random);
+                    if (uniform(random) < stepS / 30) {
+                        phase = RISE;
+                        peak = 80.f + 35.f * uniform(random);
+                        rate = 1.f + 3.f * uniform(random);
+                    }
+                    break;
+                case RISE:
+                    temperature = std::min(peak, temperature + rate * stepS);
+                    if (temperature >= peak) {
+                        phase = HOLD;
+                        holdNs = (1.f + 14.f * uniform(random)) * 1e9f;
+                    }
+                    break;
+                case HOLD:
+                    temperature = peak + noise(random);
+                    holdNs -= SYNTHETIC_STEP_NS;
+                    if (holdNs <= 0) {
+                        phase = FALL;
+                        rate = 1.f + 2.f * uniform(random);
+                    }
+                    break;
+                case FALL:
+                    temperature -= rate * stepS;
+                    if (temperature < 50.f) {
+                        phase = IDLE;
+                    }
+                    break;
+            }
+            profile.samples.push_back({ns, z, temperature});
+        }
+    }
+    std::stable_sort(profile.samples.begin(), profile.samples.end(),
+                     [](const auto& a, const auto& b) { return a.ns < b.ns; });
+    return profile;
+}
+
+static bool loadTrace(const char *path, Profile* profile) {
+    ThermalTraceReader reader;
+    if (!reader.open(path)) {
+        return false;
+    }
+    ThermalTrace::Event event;
+    int64_t firstNs = -1;
+    while (reader.next(&event)) {
+        if (firstNs < 0) {
+            firstNs = event.bootNs;
+        }
+        if (event.kind == ThermalTrace::ZONE_ADDED && event.index == profile->names.size()) {
+            profile->names.push_back(event.name);
+        } else if (event.kind == ThermalTrace::ZONE_READ && event.index < profile->names.size()) {
+            profile->samples.push_back(
+                    {event.bootNs - firstNs, event.index, event.value / 1000.f});
+            profile->lengthNs = event.bootNs - firstNs;
+        }
+    }
+    // Types name the zones in the callbacks, so they have to be unique.
+    for (size_t z = 0; z < profile->names.size(); ++z) {
+        if (std::count(profile->names.begin(), profile->names.begin() + z,
+                       profile->names[z]) > 0) {
+            profile->names[z] += "-" + std::to_string(z);
+        }
+    }
+    return !profile->samples.empty();
+}
+
+// Plays the kernel's part for a zone whose temperature went from previous
+// to temperature, in millidegrees. The fake zones report every write at
+// once, like a sensor with trip interrupts.
+static void crossTrips(FakeSysfs& sysfs, ThermalWatcher* watcher, size_t zone, long previous,
+                       long temperature) {
+    if (sysfs.crossesTrip(zone, WINDOW_TRIPS, previous, temperature)) {
+        watcher->injectUevent(FakeSysfs::changeUevent(
+                "/devices/virtual/thermal/thermal_zone" + std::to_string(zone), "thermal"));
+    }
+}
+
+static int64_t percentile(const std::vector<int64_t>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    return sorted[std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()))];
+}
+
+// Builds a fake tree with the zones of the profile, starts a watcher on it
+// and plays the profile in real time divided by speed. A severity engine
+// next to the watcher sees every temperature as it is written; each of its
+// transitions is due from the watcher, and the delay until the watcher
+// reports it is the detection latency.
+static bool run(const Profile& profile, const ThermalConfig& config, bool window, double speed,
+                uint32_t periodMs, Result* result) {
+    FakeSysfs sysfs;
+    ThermalConfig scaled = config;
+    SeverityEngine reference;
+    std::unordered_map<std::string, size_t> indices;
+    std::vector<float> temperatures(profile.names.size(), 45.f);
+    for (const auto& sample : profile.samples) {
+        if (sample.ns > 0) {
+            break;
+        }
+        temperatures[sample.zone] = lroundf(sample.temperature * 1000) * 0.001f;
+    }
+    for (size_t z = 0; z < profile.names.size(); ++z) {
+        const std::string& name = profile.names[z];
+        // Both window trips start out of the way; the watcher moves them.
+        if (!sysfs.addZone(z, name, temperatures[z]) ||
+            (window && (!sysfs.addTrip(z, 0, "passive", 150.f, 0.f) ||
+                        !sysfs.addTrip(z, 1, "passive", 150.f, 0.f) ||
+                        !sysfs.addTrip(z, 2, "critical", 150.f, 0.f)))) {
+            fprintf(stderr, "cannot create the fake tree in %s\n", sysfs.root());
+            return false;
+        }
+        ZoneConfig zone = config.zone(name);
+        reference.addZone(zone.hot, zone.cold);
+        zone.periodMs = std::max<uint32_t>(1, (periodMs > 0 ? periodMs :
+                zone.periodMs > 0 ? zone.periodMs : DEFAULT_PERIOD_MS) / speed);
+        scaled.set(name, zone);
+        indices[name] = z;
+    }
+    std::vector<SeverityEngine::Transition> transitions;
+    reference.evaluate(temperatures.data(), 0, &transitions);
+
+    struct Due {
+        SeverityLevel to;
+        int64_t ns;
+    };
+    std::mutex lock;
+    std::vector<std::deque<Due>> due(profile.names.size());
+    bool playing = false;
+    ThermalSnapshot snapshot;
+    ThermalJournal journal;
+    ThermalTimeline timeline;
+    ThermalWatcher::setRootDir(sysfs.root());
+    const ::android::sp<ThermalWatcher> watcher = new ThermalWatcher(
+            scaled, snapshot, journal, timeline,
+            [&](const std::string& name, float, SeverityLevel, SeverityLevel to) {
+                const int64_t nowNs = monotonicNs();
+                std::lock_guard<std::mutex> _lock(lock);
+                const auto it = indices.find(name);
+                if (!playing || it == indices.end()) {
+                    return;
+                }
+                // The latest transition to the same level is the one seen;
+                // any before it were over before the watcher looked.
+                auto& zoneDue = due[it->second];
+                const auto match = std::find_if(zoneDue.rbegin(), zoneDue.rend(),
+                                                [to](const Due& d) { return d.to == to; });
+                if (match == zoneDue.rend()) {
+                    return;
+                }
+                const auto end = match.base();
+                result->latenciesNs.push_back((nowNs - (end - 1)->ns) * speed);
+                result->missed += end - zoneDue.begin() - 1;
+                zoneDue.erase(zoneDue.begin(), end);
+            });
+    watcher->useInjectedUevents();
+    if (!watcher->discover(window) ||
+        !watcher->startWatching(std::string(sysfs.root()) + "/snapshot")) {
+        fprintf(stderr, "cannot start the watcher on %s\n", sysfs.root());
+        return false;
+    }
+    // The first round reads every zone and programs the windows.
+    while (watcher->stats().reads < profile.names.size()) {
+        sleepUntil(monotonicNs() + 1000000);
+    }
+    const ThermalWatcher::Stats before = watcher->stats();
+    {
+        std::lock_guard<std::mutex> _lock(lock);
+        playing = true;
+    }
+
+    const int64_t startNs = monotonicNs();
+    for (const auto& sample : profile.samples) {
+        sleepUntil(startNs + sample.ns / speed);
+        // Rounded to the millidegrees of the temp file and scaled the way
+        // the watcher reads them, so that both see the same values.
+        const long previous = lroundf(temperatures[sample.zone] * 1000);
+        const long milli = lroundf(sample.temperature * 1000);
+        temperatures[sample.zone] = milli * 0.001f;
+        transitions.clear();
+        reference.evaluate(temperatures.data(), 0, &transitions);
+        if (!transitions.empty()) {
+            std::lock_guard<std::mutex> _lock(lock);
+            for (const auto& transition : transitions) {
+                due[transition.zone].push_back({transition.to, monotonicNs()});
+                ++result->transitions;
+            }
+        }
+        sysfs.setTemperature(sample.zone, sample.temperature);
+        if (window) {
+            crossTrips(sysfs, watcher.get(), sample.zone, previous, milli);
+        }
+    }
+    // Past the end of the profile the watcher gets one more poll to catch
+    // up, then whatever it has not reported is missed.
+    sleepUntil(monotonicNs() + 2000000LL * (periodMs > 0 ? periodMs : DEFAULT_PERIOD_MS) / speed);
+    watcher->stopWatching();
+
+    const ThermalWatcher::Stats after = watcher->stats();
+    result->stats = {after.ueventWakeups - before.ueventWakeups,
+                     after.pollWakeups - before.pollWakeups, after.reads - before.reads,
+                     after.windowWrites - before.windowWrites,
+                     after.transitions - before.transitions};
+    std::lock_guard<std::mutex> _lock(lock);
+    playing = false;
+    for (const auto& zoneDue : due) {
+        result->missed += zoneDue.size();
+    }
+    return true;
+}
+
+// Plays a temperature recording, or a synthetic one, into the watcher on a
+// fake tree, once sleeping on trip windows and once polling, and compares
+// how often each wakes up and how soon each reports a level transition.
+// Rates and latencies are on the clock of the recording.
+int main(int argc, char **argv) {
+    std::string configPath = "/vendor/etc/thermal-renesas.conf";
+    double speed = 10;
+    uint32_t periodMs = 0;
+    size_t zones = 8;
+    int64_t lengthNs = 300000000000LL;
+    std::vector<bool> modes = {true, false};
+    int opt;
+    while ((opt = getopt(argc, argv, "c:s:p:z:d:m:")) != -1) {
+        switch (opt) {
+            case 'c':
+                configPath = optarg;
+                break;
+            case 's':
+                speed = atof(optarg);
+                break;
+            case 'p':
+                periodMs = atoi(optarg);
+                break;
+            case 'z':
+                zones = atoi(optarg);
+                break;
+            case 'd':
+                lengthNs = atof(optarg) * 1e9;
+                break;
+            case 'm':
+                modes.clear();
+                for (const auto& mode : ::android::base::Split(optarg, ",")) {
+                    if (mode != "window" && mode != "poll") {
+                        usage(argv[0]);
+                        return 1;
+                    }
+                    modes.push_back(mode == "window");
+                }
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (optind < argc - 1 || speed <= 0 || zones == 0 || lengthNs <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    ZoneConfig defaults;
+    defaults.hot.fill(NAN);
+    defaults.cold.fill(NAN);
+    ThermalConfig config(defaults);
+    if (!config.load(configPath)) {
+        fprintf(stderr, "cannot read %s\n", configPath.c_str());
+        return 1;
+    }
+    Profile profile;
+    if (optind == argc - 1) {
+        if (!loadTrace(argv[optind], &profile)) {
+            fprintf(stderr, "no zone reads in %s\n", argv[optind]);
+            return 1;
+        }
+    } else {
+        profile = synthesize(zones, lengthNs);
+    }
+
+    printf("%zu zones, %.0f s at %gx\n", profile.names.size(), profile.lengthNs / 1e9, speed);
+    printf("mode    wakeups/h   reads/h  trip writes  transitions  missed   p50 ms   p90 ms"
+           "   p99 ms   max ms\n");
+    const double hours = profile.lengthNs / 3600e9;
+    for (bool window : modes) {
+        Result result;
+        if (!run(profile, config, window, speed, periodMs, &result)) {
+            return 1;
+        }
+        auto& latencies = result.latenciesNs;
+        std::sort(latencies.begin(), latencies.end());
+        printf("%-6s  %9.0f  %8.0f  %11" PRIu64 "  %11" PRIu64 "  %6" PRIu64
+               "  %7.1f  %7.1f  %7.1f  %7.1f\n",
+               window ? "window" : "poll",
+               (result.stats.ueventWakeups + result.stats.pollWakeups) / hours,
+               result.stats.reads / hours, result.stats.windowWrites, result.transitions,
+               result.missed, percentile(latencies, .5) / 1e6, percentile(latencies, .9) / 1e6,
+               percentile(latencies, .99) / 1e6, latencies.empty() ? 0. : latencies.back() / 1e6);
+    }
+    return 0;
+}
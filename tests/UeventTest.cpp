@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2026 Renesas Electronics Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <math.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "FakeSysfs.h"
+#include "ThermalWatcher.h"
+
+namespace android {
+namespace hardware {
+namespace thermal {
+namespace V1_1 {
+namespace renesas {
+
+static constexpr int kTripZone = 2;
+
+static std::string uevent(const std::string& action, const std::string& devpath,
+                          const std::string& subsystem) {
+    std::string msg;
+    for (const std::string& field :
+         {"ACTION=" + action, "DEVPATH=" + devpath, "SUBSYSTEM=" + subsystem}) {
+        msg += field;
+        msg += '\0';
+    }
+    return msg;
+}
+
+static std::string zonePath(int id) {
+    return "/devices/virtual/thermal/thermal_zone" + std::to_string(id);
+}
+
+// A watcher on a fake tree of three zones and four CPUs that takes its
+// uevents from the test. The polled zones are due once a minute, so every
+// read in a test comes from an event; the last zone has a trip window.
+class UeventTest : public ::testing::Test {
+  protected:
+    UeventTest() : mConfig(polledOnce()) {}
+
+    static ZoneConfig polledOnce() {
+        ZoneConfig config;
+        config.hot.fill(NAN);
+        config.cold.fill(NAN);
+        config.hot[static_cast<size_t>(SeverityLevel::SEVERE)] = 100.f;
+        config.cold[static_cast<size_t>(SeverityLevel::SEVERE)] = 98.f;
+        config.periodMs = 60000;
+        return config;
+    }
+
+    void SetUp() override {
+        for (int z = 0; z <= kTripZone; ++z) {
+            ASSERT_TRUE(mSysfs.addZone(z, "sensor-thermal" + std::to_string(z + 1), 45.f));
+        }
+        ASSERT_TRUE(mSysfs.addTrip(kTripZone, 0, "passive", 150.f, 0.f));
+        ASSERT_TRUE(mSysfs.addTrip(kTripZone, 1, "passive", 150.f, 0.f));
+        ASSERT_TRUE(mSysfs.addCpus(4));
+        ThermalWatcher::setRootDir(mSysfs.root());
+        mWatcher = new ThermalWatcher(mConfig, mSnapshot, mJournal, mTimeline,
+                                      [](const std::string&, float, SeverityLevel,
+                                         SeverityLevel) {});
+        mWatcher->useInjectedUevents();
+        ASSERT_TRUE(mWatcher->discover(true));
+        ASSERT_TRUE(mWatcher->startWatching(std::string(mSysfs.root()) + "/snapshot"));
+        ASSERT_TRUE(waitFor([this] { return mWatcher->stats().reads >= kTripZone + 1; }));
+    }
+
+    void TearDown() override {
+        if (mWatcher != nullptr) {
+            mWatcher->stopWatching();
+        }
+        ThermalWatcher::setRootDir("");
+    }
+
+    static bool waitFor(const std::function<bool()>& condition) {
+        for (int i = 0; i < 2000; ++i) {
+            if (condition()) {
+                return true;
+            }
+            usleep(1000);
+        }
+        return condition();
+    }
+
+    // Injects msg and waits until the thread has taken it.
+    void inject(const std::string& msg) {
+        const uint64_t wakeups = mWatcher->stats().ueventWakeups;
+        mWatcher->injectUevent(msg);
+        ASSERT_TRUE(waitFor([&] { return mWatcher->stats().ueventWakeups > wakeups; }));
+    }
+
+    bool isLive(size_t index) {
+        const auto table = mWatcher->zoneTable();
+        return std::find(table->live.begin(), table->live.end(), index) != table->live.end();
+    }
+
+    FakeSysfs mSysfs;
+    ThermalConfig mConfig;
+    ThermalSnapshot mSnapshot;
+    ThermalJournal mJournal;
+    ThermalTimeline mTimeline;
+    sp<ThermalWatcher> mWatcher;
+};
+
+TEST_F(UeventTest, ChangeReadsTheZoneThatSentIt) {
+    const uint64_t reads = mWatcher->stats().reads;
+    inject(uevent("change", zonePath(kTripZone), "thermal"));
+    EXPECT_EQ(reads + 1, mWatcher->stats().reads);
+}
+
+TEST_F(UeventTest, ChangeWithoutZoneReadsTripZones) {
+    const uint64_t reads = mWatcher->stats().reads;
+    inject(uevent("change", "/devices/virtual/thermal/", "thermal"));
+    EXPECT_EQ(reads + 1, mWatcher->stats().reads);
+}
+
+TEST_F(UeventTest, AddedZoneJoinsTheTable) {
+    ASSERT_TRUE(mSysfs.addZone(5, "gpu-thermal", 50.f));
+    inject(uevent("add", zonePath(5), "thermal"));
+    const auto table = mWatcher->zoneTable();
+    ASSERT_EQ(static_cast<size_t>(kTripZone + 2), table->zones.size());
+    EXPECT_TRUE(isLive(kTripZone + 1));
+    ASSERT_EQ(1u, table->byClass[static_cast<size_t>(ZoneClass::GPU)].size());
+    EXPECT_EQ(static_cast<size_t>(kTripZone + 1),
+              table->byClass[static_cast<size_t>(ZoneClass::GPU)][0]);
+}
+
+TEST_F(UeventTest, AddingALiveZoneChangesNothing) {
+    const auto before = mWatcher->zoneTable();
+    inject(uevent("add", zonePath(0), "thermal"));
+    EXPECT_EQ(before, mWatcher->zoneTable());
+}
+
+TEST_F(UeventTest, RemovedZoneKeepsItsIndex) {
+    inject(uevent("remove", zonePath(1), "thermal"));
+    const auto table = mWatcher->zoneTable();
+    ASSERT_EQ(static_cast<size_t>(kTripZone + 1), table->zones.size());
+    EXPECT_FALSE(isLive(1));
+    EXPECT_EQ(nullptr, table->zones[1].tempFd);
+    EXPECT_TRUE(table->byName.find("sensor-thermal2") == table->byName.end());
+
+    inject(uevent("add", zonePath(1), "thermal"));
+    EXPECT_EQ(static_cast<size_t>(kTripZone + 1), mWatcher->zoneTable()->zones.size());
+    EXPECT_TRUE(isLive(1));
+}
+
+TEST_F(UeventTest, HwmonRescansZones) {
+    ASSERT_TRUE(mSysfs.addZone(7, "sensor-thermal8", 50.f));
+    inject(uevent("add", "/devices/platform/e6198000.thermal/hwmon/hwmon0", "hwmon"));
+    EXPECT_EQ(static_cast<size_t>(kTripZone + 2), mWatcher->zoneTable()->live.size());
+}
+
+TEST_F(UeventTest, CpuHotplug) {
+    ASSERT_TRUE(mWatcher->isCpuOnline(2));
+    inject(uevent("offline", "/devices/system/cpu/cpu2", "cpu"));
+    EXPECT_FALSE(mWatcher->isCpuOnline(2));
+    EXPECT_TRUE(mWatcher->isCpuOnline(1));
+    inject(uevent("online", "/devices/system/cpu/cpu2", "cpu"));
+    EXPECT_TRUE(mWatcher->isCpuOnline(2));
+}
+
+TEST_F(UeventTest, OtherEventsAreIgnored) {
+    const auto table = mWatcher->zoneTable();
+    const uint64_t reads = mWatcher->stats().reads;
+    inject(uevent("change", "/devices/platform/soc/ee100000.mmc", "mmc"));
+    inject(uevent("offline", "/devices/system/cpu/cpu99", "cpu"));
+    inject(uevent("change", "/devices/virtual/thermal/cooling_device0", "thermal"));
+    inject("ACTION=change");
+    EXPECT_EQ(table, mWatcher->zoneTable());
+    EXPECT_EQ(reads, mWatcher->stats().reads);
+    EXPECT_TRUE(mWatcher->isCpuOnline(3));
+}
+
+}  // namespace renesas
+}  // namespace V1_1
+}  // namespace thermal
+}  // namespace hardware
+}  // namespace android